@@ -8,15 +8,29 @@
 #include "device.cpp"
 #include "scope.cpp"
 #include "wavegen.cpp"
+#include "network.cpp"
 #include "supplies.cpp"
+#include "supplies_monitor.cpp"
+#include "supplies_sequencer.cpp"
 #include "dmm.cpp"
+#include "dmm_stream.cpp"
 #include "logic.cpp"
 #include "pattern.cpp"
+#include "pattern_stream.cpp"
 #include "static.cpp"
+#include "static_watcher.cpp"
 #include "protocol/uart.cpp"
+#include "protocol/uart_stream.cpp"
 #include "protocol/spi.cpp"
 #include "protocol/i2c.cpp"
+#include "manager.cpp"
 
+#include "fft.cpp"
+#include "welch.cpp"
+#include "spectrogram.cpp"
+#include "quality.cpp"
+#include "correlation.cpp"
 #include "tools.cpp"
+#include "scheduler.cpp"
 
 #endif
@@ -0,0 +1,199 @@
+/* CROSS-CORRELATION FUNCTIONS: correlate, measure */
+
+/* include the header */
+#include "correlation.h"
+
+/* ----------------------------------------------------- */
+
+void wf::Correlation::correlate(const double *reference, const double *signal, int length, double *output) {
+    /*
+        calculate the cross-correlation of two signals, the averages are removed
+
+        parameters: - reference - the first signal
+                    - signal - the second signal, sampled together with the reference
+                    - length - number of samples in each signal
+                    - output - buffer for 2 * length - 1 values, from lag -(length - 1) to length - 1,
+                               output[length - 1 + lag] is the sum of reference[n] * signal[n + lag]
+    */
+    if (length < 1) {
+        return;
+    }
+    thread_local std::vector<std::complex<double>> work;
+    double energy = 0;
+    int size = transform(reference, signal, length, work, energy);
+    for (int lag = -(length - 1); lag < length; lag++) {
+        output[length - 1 + lag] = work[lag < 0 ? size + lag : lag].real();
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+std::vector<double> wf::Correlation::correlate(const std::vector<double> &reference, const std::vector<double> &signal) {
+    /*
+        calculate the cross-correlation of two signals, the averages are removed
+
+        parameters: - reference - the first signal
+                    - signal - the second signal, sampled together with the reference
+
+        returns:    - 2 * length - 1 values, from lag -(length - 1) to length - 1
+    */
+    int length = int(reference.size() < signal.size() ? reference.size() : signal.size());
+    std::vector<double> result(length > 0 ? 2 * length - 1 : 0);
+    correlate(reference.data(), signal.data(), length, result.data());
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Correlation::Data wf::Correlation::measure(const double *reference, const double *signal, int length, double sample_rate, double max_delay, double frequency) {
+    /*
+        measure the delay and the phase of a signal relative to a reference
+
+        parameters: - reference - the first signal, for example scope channel 1
+                    - signal - the second signal from the same acquisition, for example scope channel 2
+                    - length - number of samples in each signal
+                    - sample rate of the signals in Hz
+                    - max_delay - the largest expected delay in seconds, 0 searches every lag,
+                                  periodic signals have a peak in every period, so limit it below half a period
+                    - frequency - frequency of the phase measurement in Hz, 0 uses the strongest component of the reference
+
+        returns:    - delay in seconds and samples, correlation coefficient, frequency and phase in degrees
+    */
+    Data data;
+    if (length < 2 || sample_rate <= 0) {
+        return data;
+    }
+
+    // the highest correlation in the allowed lag range
+    thread_local std::vector<std::complex<double>> work;
+    double energy = 0;
+    int size = transform(reference, signal, length, work, energy);
+    int range = length - 1;
+    if (max_delay > 0 && max_delay * sample_rate < range) {
+        range = int(max_delay * sample_rate);
+    }
+    int peak = 0;
+    double best = work[0].real();
+    for (int lag = -range; lag <= range; lag++) {
+        double value = work[lag < 0 ? size + lag : lag].real();
+        if (value > best) {
+            best = value;
+            peak = lag;
+        }
+    }
+
+    // interpolate the peak between the samples with a parabola
+    double left = work[peak - 1 < 0 ? size + peak - 1 : peak - 1].real();
+    double right = work[peak + 1 < 0 ? size + peak + 1 : peak + 1].real();
+    double curvature = left - 2 * best + right;
+    double offset = curvature < 0 ? 0.5 * (left - right) / curvature : 0;
+    data.lag = peak + offset;
+    data.delay = data.lag / sample_rate;
+    data.coefficient = energy > 0 ? best / energy : 0;
+
+    // the strongest component of the reference, if no frequency is given
+    if (frequency <= 0) {
+        thread_local std::vector<std::complex<double>> bins;
+        bins.resize(length / 2 + 1);
+        fft.real(reference, length, bins.data());
+        int bin = 1;
+        for (int index = 2; index <= length / 2; index++) {
+            if (std::norm(bins[index]) > std::norm(bins[bin])) {
+                bin = index;
+            }
+        }
+        double sum = 0, weight = 0;
+        for (int index = bin - 1; index <= bin + 1 && index <= length / 2; index++) {
+            sum += index * std::norm(bins[index]);
+            weight += std::norm(bins[index]);
+        }
+        frequency = (weight > 0 ? sum / weight : bin) * sample_rate / length;
+    }
+    data.frequency = frequency;
+
+    // phase difference of the windowed signals at the frequency
+    std::shared_ptr<const std::vector<double>> coefficients = fft.window(DwfWindowHann, length);
+    const double *weights = coefficients->data();
+    thread_local std::vector<double> windowed;
+    windowed.resize(length);
+    std::complex<double> reference_bin, signal_bin;
+    for (int index = 0; index < length; index++) {
+        windowed[index] = reference[index] * weights[index];
+    }
+    fft.zoom(windowed.data(), length, frequency / sample_rate, 0, 1, &reference_bin);
+    for (int index = 0; index < length; index++) {
+        windowed[index] = signal[index] * weights[index];
+    }
+    fft.zoom(windowed.data(), length, frequency / sample_rate, 0, 1, &signal_bin);
+    data.phase = std::arg(signal_bin / reference_bin) * 180.0 / pi;
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Correlation::Data wf::Correlation::measure(const std::vector<double> &reference, const std::vector<double> &signal, double sample_rate, double max_delay, double frequency) {
+    /*
+        measure the delay and the phase of a signal relative to a reference
+
+        parameters: - reference - the first signal, for example scope channel 1
+                    - signal - the second signal from the same acquisition, for example scope channel 2
+                    - sample rate of the signals in Hz
+                    - max_delay - the largest expected delay in seconds, 0 searches every lag
+                    - frequency - frequency of the phase measurement in Hz, 0 uses the strongest component of the reference
+
+        returns:    - delay in seconds and samples, correlation coefficient, frequency and phase in degrees
+    */
+    int length = int(reference.size() < signal.size() ? reference.size() : signal.size());
+    return measure(reference.data(), signal.data(), length, sample_rate, max_delay, frequency);
+}
+
+/* ----------------------------------------------------- */
+
+int wf::Correlation::transform(const double *reference, const double *signal, int length, std::vector<std::complex<double>> &work, double &energy) {
+    /*
+        circular cross-correlation without wrap around, work[lag] (work[size + lag] for negative lags)
+        is the sum of reference[n] * signal[n + lag], energy is the norm used for the correlation coefficient
+
+        both signals are transformed together: the reference is the real part, the signal the imaginary part
+    */
+    int size = 1;
+    while (size < 2 * length - 1) {
+        size <<= 1;
+    }
+
+    // remove the averages
+    double reference_mean = 0, signal_mean = 0;
+    for (int index = 0; index < length; index++) {
+        reference_mean += reference[index];
+        signal_mean += signal[index];
+    }
+    reference_mean /= length;
+    signal_mean /= length;
+    double reference_energy = 0, signal_energy = 0;
+    work.assign(size, std::complex<double>(0, 0));
+    for (int index = 0; index < length; index++) {
+        double x = reference[index] - reference_mean;
+        double y = signal[index] - signal_mean;
+        work[index] = std::complex<double>(x, y);
+        reference_energy += x * x;
+        signal_energy += y * y;
+    }
+    energy = sqrt(reference_energy * signal_energy);
+    fft.transform(work.data(), size);
+
+    // separate the two spectra and multiply the signal with the conjugate of the reference, bins k and size - k together
+    const std::complex<double> minus_half_i(0, -0.5);
+    for (int index = 0; index <= size / 2; index++) {
+        int mirror = (size - index) % size;
+        std::complex<double> upper = work[index];
+        std::complex<double> lower = work[mirror];
+        std::complex<double> x = 0.5 * (upper + std::conj(lower));
+        std::complex<double> y = minus_half_i * (upper - std::conj(lower));
+        work[index] = std::conj(x) * y;
+        // the other bin has the conjugate spectra, so the product is conjugated too
+        work[mirror] = std::conj(work[index]);
+    }
+    fft.inverse(work.data(), size);
+    return size;
+}
@@ -0,0 +1,48 @@
+/* CROSS-CORRELATION FUNCTIONS: correlate, measure */
+
+/* include the necessary libraries */
+#include <vector>
+#include <complex>
+#include <memory>
+#include <cmath>
+#include "dwf.h"
+#include "fft.h"
+#include "tools.h"
+
+#ifndef WF_CORRELATION
+#define WF_CORRELATION
+namespace wf {
+
+class Correlation {
+    public:
+        class Data {
+            public:
+                double delay = 0;               // delay of the signal after the reference in seconds
+                double lag = 0;                 // the same delay in samples, interpolated between the samples
+                double coefficient = 0;         // normalized correlation at the delay (-1 to 1)
+                double frequency = 0;           // frequency of the phase measurement in Hz
+                double phase = 0;               // phase of the signal relative to the reference in degrees (-180 to 180)
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        delay = data.delay;
+                        lag = data.lag;
+                        coefficient = data.coefficient;
+                        frequency = data.frequency;
+                        phase = data.phase;
+                    }
+                    return *this;
+                }
+        };
+
+    private:
+        int transform(const double *reference, const double *signal, int length, std::vector<std::complex<double>> &work, double &energy);
+
+    public:
+        void correlate(const double *reference, const double *signal, int length, double *output);
+        std::vector<double> correlate(const std::vector<double> &reference, const std::vector<double> &signal);
+        Data measure(const double *reference, const double *signal, int length, double sample_rate, double max_delay = 0, double frequency = 0);
+        Data measure(const std::vector<double> &reference, const std::vector<double> &signal, double sample_rate, double max_delay = 0, double frequency = 0);
+} correlation;
+
+}
+#endif
@@ -1,11 +1,16 @@
-/* DEVICE CONTROL FUNCTIONS: open, check_error, close, temperature */
+/* DEVICE CONTROL FUNCTIONS: open, open_index, get_info, check_error, last_status, check_status, close, temperature */
 
 /* include the header */
 #include "device.h"
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 /* ----------------------------------------------------- */
 
-wf::Device::Data* wf::Device::open(std::string device, int config) {
+wf::Device::Data* wf::Device::open(std::string device, int config, bool use_cache) {
     /*
         open a specific device
 
@@ -13,19 +18,16 @@ wf::Device::Data* wf::Device::open(std::string device, int config) {
                                    "Analog Discovery Studio", "Digital Discovery",
                                    "Analog Discovery Pro 3X50", "Analog Discovery Pro 5250"
                     - configuration
+                    - use_cache - load the device information from the disk cache if possible, default is True
+                                  (the cache directory is WF_SDK_CACHE, or the temporary directory)
+
+                    the device information is queried by the instruments when they need it, see get_info
 
         returns:    - device data
     */
 
     Data *device_data = new Data();
-
-    std::map<std::string, int> device_names;
-    device_names["Analog Discovery"] = devidDiscovery;
-    device_names["Analog Discovery 2"] = devidDiscovery2;
-    device_names["Analog Discovery Studio"] = devidDiscovery2;
-    device_names["Digital Discovery"] = devidDDiscovery;
-    device_names["Analog Discovery Pro 3X50"] = devidADP3X50;
-    device_names["Analog Discovery Pro 5250"] = devidADP5250;
+    std::map<std::string, int> device_names = names();
 
     // decode device names
     ENUMFILTER device_type = enumfilterAll;
@@ -63,12 +65,47 @@ wf::Device::Data* wf::Device::open(std::string device, int config) {
         index++;    // increment the index and try again if the device is busy
     }
 
+    setup(device_data, index - 1, config, use_cache);
+    return device_data;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Device::Data* wf::Device::open_index(int index, int config, bool use_cache) {
+    /*
+        open the device with the given index of the last enumeration
+
+        parameters: - device index, the devices are enumerated with FDwfEnum
+                    - configuration
+                    - use_cache - load the device information from the disk cache if possible, default is True
+
+        returns:    - device data
+    */
+    Data *device_data = new Data();
+    FDwfDeviceConfigOpen(index, config, &device_data->handle);
+    setup(device_data, index, config, use_cache);
+    return device_data;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Device::setup(Data* device_data, int index, int config, bool use_cache) {
+    /*
+        check the result of the connection and fill in the device name and version
+
+        parameters: - device data with the handle of the opened device
+                    - device index
+                    - configuration
+                    - use_cache - load the device information from the disk cache if possible
+    */
+    std::map<std::string, int> device_names = names();
+
     // check connected device type
     device_data->name = "";
+    int device_id = 0;
+    int device_rev = 0;
     if (device_data->handle != 0) {
-        int device_id = 0;
-        int device_rev = 0;
-        FDwfEnumDeviceType(index - 1, &device_id, &device_rev);
+        FDwfEnumDeviceType(index, &device_id, &device_rev);
 
         // decode device id
         for (std::map<std::string, int>::iterator pair = device_names.begin(); pair != device_names.end(); ++pair) {
@@ -93,9 +130,35 @@ wf::Device::Data* wf::Device::open(std::string device, int config) {
         }
     }
 
-    // set global data
-    get_info(device_data);
-    return device_data;
+    // check WaveForms version
+    char version[16];
+    if (FDwfGetVersion(version) == 0) {
+        check_error(device_data);
+    }
+    device_data->version = std::string(version);
+
+    // reuse the device information saved for this device, configuration and WaveForms version
+    if (use_cache) {
+        device_data->cache = cache_path(device_id, device_rev, config, device_data->version);
+        load_info(device_data, device_data->cache);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+std::map<std::string, int> wf::Device::names(void) {
+    /*
+        get the device ids of the supported device names
+    */
+    std::map<std::string, int> device_names;
+    device_names["Analog Discovery"] = devidDiscovery;
+    device_names["Analog Discovery 2"] = devidDiscovery2;
+    device_names["Analog Discovery Studio"] = devidDiscovery2;
+    device_names["Digital Discovery"] = devidDDiscovery;
+    device_names["Analog Discovery Pro 3X50"] = devidADP3X50;
+    device_names["Analog Discovery Pro 5250"] = devidADP5250;
+    return device_names;
 }
 
 /* ----------------------------------------------------- */
@@ -109,23 +172,7 @@ void wf::Device::check_error(Data *device_data, const char *caller, const char *
     device_data->error.message = err_msg;   // cast it to string
     if (device_data->error.message != "") {
         device_data->error.function = caller;
-        device_data->error.instrument = file;
-        // delete the extension
-        size_t index = device_data->error.instrument.find('.');
-        if (index != std::string::npos) {
-            device_data->error.instrument = device_data->error.instrument.substr(0, index);
-        }
-        // delete the path
-        device_data->error.instrument = std::string(device_data->error.instrument.rbegin(), device_data->error.instrument.rend());
-        index = device_data->error.instrument.find('/');
-        if (index != std::string::npos) {
-            device_data->error.instrument = device_data->error.instrument.substr(0, index);
-        }
-        index = device_data->error.instrument.find('\\');
-        if (index != std::string::npos) {
-            device_data->error.instrument = device_data->error.instrument.substr(0, index);
-        }
-        device_data->error.instrument = std::string(device_data->error.instrument.rbegin(), device_data->error.instrument.rend());
+        device_data->error.instrument = Status(Status::error, 0, caller, file).instrument();
         throw device_data->error;
     }
     return;
@@ -133,10 +180,55 @@ void wf::Device::check_error(Data *device_data, const char *caller, const char *
 
 /* ----------------------------------------------------- */
 
+wf::Status wf::Device::last_status(const char *caller, const char *file) {
+    /*
+        get the status of the last failed SDK call without throwing,
+        the error message is only fetched if it is requested
+
+        parameters: - caller function name, filled in automatically
+                    - caller file name, filled in automatically
+
+        returns:    - status with the error code of the SDK
+    */
+    int err_nr = 0;
+    FDwfGetLastError(&err_nr);
+    return Status(Status::error, err_nr, caller, file);
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Device::check_status(Data *device_data, const Status &status) {
+    /*
+        throw the result of a non-throwing function: SDK errors as Error, protocol errors as Warning
+
+        parameters: - device data
+                    - status
+    */
+    if (status.code == Status::ok) {
+        return;
+    }
+    if (status.code == Status::error) {
+        device_data->error.message = status.message();
+        device_data->error.function = status.function;
+        device_data->error.instrument = status.instrument();
+        throw device_data->error;
+    }
+    device_data->warning.message = status.message();
+    device_data->warning.function = status.function;
+    device_data->warning.instrument = status.instrument();
+    throw device_data->warning;
+}
+
+/* ----------------------------------------------------- */
+
 void wf::Device::close(Data *device_data) {
     /*
-        close a specific device
+        close a specific device, the background threads using it are stopped first
     */
+    std::map<void*, std::function<void(void)>> engines = device_data->engines;
+    for (std::map<void*, std::function<void(void)>>::iterator engine = engines.begin(); engine != engines.end(); ++engine) {
+        engine->second();
+    }
     if (device_data->handle != 0) {
         FDwfDeviceClose(device_data->handle);
     }
@@ -150,27 +242,11 @@ double wf::Device::temperature(Data *device_data) {
     /*
         return the board temperature
     */
-    // find the system monitor
-    int channel = -1;
-    for (int channel_index = 0; channel_index < device_data->analog.IO.channel_count; channel_index++) {
-        if (device_data->analog.IO.channel_label[channel_index] == "System") {
-            channel = channel_index;
-            break;
-        }
-    }
-    if (channel < 0) {
-        return 0;
-    }
-
-    // find the temperature node
-    int node = -1;
-    for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel]; node_index++) {
-        if (device_data->analog.IO.node_name[channel][node_index] == "Temp") {
-            node = node_index;
-            break;
-        }
-    }
-    if (node < 0) {
+    // the system monitor node is resolved with the analog IO information
+    get_info(device_data, info.analog_IO);
+    int channel = device_data->analog.IO.index.temperature.channel;
+    int node = device_data->analog.IO.index.temperature.node;
+    if (channel < 0 || node < 0) {
         return 0;
     }
 
@@ -187,200 +263,566 @@ double wf::Device::temperature(Data *device_data) {
 
 /* ----------------------------------------------------- */
 
-void wf::Device::get_info(Data* device_data) {
+void wf::Device::get_info(Data* device_data, int sections) {
     /*
-        get device information
-    */
+        get device information, only the sections which weren't queried yet
 
-    // check WaveForms version
-    char version[16];
-    if (FDwfGetVersion(version) == 0) {
-        check_error(device_data);
+        parameters: - device data
+                    - sections: combination of device.info.analog_input, analog_output, analog_IO,
+                                digital_input, digital_output, or device.info.all
+    */
+    sections &= ~device_data->info;
+    if (sections == 0) {
+        return;
     }
-    device_data->version = std::string(version);
+    int handle = device_data->handle;
 
     // analog input information
-    // channel count
-    int handle = device_data->handle;
-    if (FDwfAnalogInChannelCount(handle, &device_data->analog.input.channel_count) == 0) {
-        check_error(device_data);
-    }
-    // buffer size
-    if (FDwfAnalogInBufferSizeInfo(handle, 0, &device_data->analog.input.max_buffer_size) == 0) {
-        check_error(device_data);
-    }
-    // ADC resolution
-    if (FDwfAnalogInBitsInfo(handle, &device_data->analog.input.max_resolution) == 0) {
-        check_error(device_data);
-    }
-    // range information
-    if (FDwfAnalogInChannelRangeInfo(handle, &device_data->analog.input.min_range, &device_data->analog.input.max_range, &device_data->analog.input.steps_range) == 0) {
-        check_error(device_data);
-    }
-    // offset information
-    if (FDwfAnalogInChannelOffsetInfo(handle, &device_data->analog.input.min_offset, &device_data->analog.input.max_offset, &device_data->analog.input.steps_offset) == 0) {
-        check_error(device_data);
+    if (sections & info.analog_input) {
+        // channel count
+        if (FDwfAnalogInChannelCount(handle, &device_data->analog.input.channel_count) == 0) {
+            check_error(device_data);
+        }
+        // buffer size
+        if (FDwfAnalogInBufferSizeInfo(handle, 0, &device_data->analog.input.max_buffer_size) == 0) {
+            check_error(device_data);
+        }
+        // ADC resolution
+        if (FDwfAnalogInBitsInfo(handle, &device_data->analog.input.max_resolution) == 0) {
+            check_error(device_data);
+        }
+        // range information
+        if (FDwfAnalogInChannelRangeInfo(handle, &device_data->analog.input.min_range, &device_data->analog.input.max_range, &device_data->analog.input.steps_range) == 0) {
+            check_error(device_data);
+        }
+        // offset information
+        if (FDwfAnalogInChannelOffsetInfo(handle, &device_data->analog.input.min_offset, &device_data->analog.input.max_offset, &device_data->analog.input.steps_offset) == 0) {
+            check_error(device_data);
+        }
     }
 
     // analog output information
-    // channel count
-    if (FDwfAnalogOutCount(handle, &device_data->analog.output.channel_count) == 0) {
-        check_error(device_data);
-    }
-    for (int channel_index = 0; channel_index < device_data->analog.output.channel_count; channel_index++) {
-        // check node types and count
-        int temp1;
-        if (FDwfAnalogOutNodeInfo(handle, channel_index, &temp1) == 0) {
+    if (sections & info.analog_output) {
+        // channel count
+        if (FDwfAnalogOutCount(handle, &device_data->analog.output.channel_count) == 0) {
             check_error(device_data);
         }
-        std::vector<std::string> templist1;
-        for (int node_index = 0; node_index < 3; node_index++) {
-            if (((1 << node_index) & temp1) == 0) {
-                continue;
+        for (int channel_index = 0; channel_index < device_data->analog.output.channel_count; channel_index++) {
+            // check node types and count
+            int temp1;
+            if (FDwfAnalogOutNodeInfo(handle, channel_index, &temp1) == 0) {
+                check_error(device_data);
             }
-            else if (node_index == AnalogOutNodeCarrier) {
-                templist1.insert(templist1.end(), std::string("carrier"));
+            std::vector<std::string> templist1;
+            for (int node_index = 0; node_index < 3; node_index++) {
+                if (((1 << node_index) & temp1) == 0) {
+                    continue;
+                }
+                else if (node_index == AnalogOutNodeCarrier) {
+                    templist1.insert(templist1.end(), std::string("carrier"));
+                }
+                else if (node_index == AnalogOutNodeFM) {
+                    templist1.insert(templist1.end(), std::string("FM"));
+                }
+                else if (node_index == AnalogOutNodeAM) {
+                    templist1.insert(templist1.end(), std::string("AM"));
+                }
             }
-            else if (node_index == AnalogOutNodeFM) {
-                templist1.insert(templist1.end(), std::string("FM"));
+            device_data->analog.output.node_type.insert(device_data->analog.output.node_type.end(), templist1);
+            device_data->analog.output.node_count.insert(device_data->analog.output.node_count.end(), device_data->analog.output.node_type[channel_index].size());
+            // buffer size
+            std::vector<int> templist2;
+            for (int node_index = 0; node_index < device_data->analog.output.node_count[channel_index]; node_index++) {
+                if (FDwfAnalogOutNodeDataInfo(handle, channel_index, node_index, 0, &temp1) == 0) {
+                    check_error(device_data);
+                }
+                templist2.insert(templist2.end(), temp1);
             }
-            else if (node_index == AnalogOutNodeAM) {
-                templist1.insert(templist1.end(), std::string("AM"));
+            device_data->analog.output.max_buffer_size.insert(device_data->analog.output.max_buffer_size.end(), templist2);
+            // amplitude information
+            std::vector<double> templist3, templist4;
+            double temp3, temp4;
+            for (int node_index = 0; node_index < device_data->analog.output.node_count[channel_index]; node_index++) {
+                if (FDwfAnalogOutNodeAmplitudeInfo(handle, channel_index, node_index, &temp3, &temp4) == 0) {
+                    check_error(device_data);
+                }
+                templist3.insert(templist3.end(), temp3);
+                templist4.insert(templist4.end(), temp4);
             }
-        }
-        device_data->analog.output.node_type.insert(device_data->analog.output.node_type.end(), templist1);
-        device_data->analog.output.node_count.insert(device_data->analog.output.node_count.end(), device_data->analog.output.node_type[channel_index].size());
-        // buffer size
-        std::vector<int> templist2;
-        for (int node_index = 0; node_index < device_data->analog.output.node_count[channel_index]; node_index++) {
-            if (FDwfAnalogOutNodeDataInfo(handle, channel_index, node_index, 0, &temp1) == 0) {
-                check_error(device_data);
+            device_data->analog.output.min_amplitude.insert(device_data->analog.output.min_amplitude.end(), templist3);
+            device_data->analog.output.max_amplitude.insert(device_data->analog.output.max_amplitude.end(), templist4);
+            // offset information
+            templist3.clear();
+            templist4.clear();
+            for (int node_index = 0; node_index < device_data->analog.output.node_count[channel_index]; node_index++) {
+                if (FDwfAnalogOutNodeOffsetInfo(handle, channel_index, node_index, &temp3, &temp4) == 0) {
+                    check_error(device_data);
+                }
+                templist3.insert(templist3.end(), temp3);
+                templist4.insert(templist4.end(), temp4);
             }
-            templist2.insert(templist2.end(), temp1);
-        }
-        device_data->analog.output.max_buffer_size.insert(device_data->analog.output.max_buffer_size.end(), templist2);
-        // amplitude information
-        std::vector<double> templist3, templist4;
-        double temp3, temp4;
-        for (int node_index = 0; node_index < device_data->analog.output.node_count[channel_index]; node_index++) {
-            if (FDwfAnalogOutNodeAmplitudeInfo(handle, channel_index, node_index, &temp3, &temp4) == 0) {
-                check_error(device_data);
+            device_data->analog.output.min_offset.insert(device_data->analog.output.min_offset.end(), templist3);
+            device_data->analog.output.max_offset.insert(device_data->analog.output.max_offset.end(), templist4);
+            // frequency information
+            templist3.clear();
+            templist4.clear();
+            for (int node_index = 0; node_index < device_data->analog.output.node_count[channel_index]; node_index++) {
+                if (FDwfAnalogOutNodeFrequencyInfo(handle, channel_index, node_index, &temp3, &temp4) == 0) {
+                    check_error(device_data);
+                }
+                templist3.insert(templist3.end(), temp3);
+                templist4.insert(templist4.end(), temp4);
             }
-            templist3.insert(templist3.end(), temp3);
-            templist4.insert(templist4.end(), temp4);
+            device_data->analog.output.min_frequency.insert(device_data->analog.output.min_frequency.end(), templist3);
+            device_data->analog.output.max_frequency.insert(device_data->analog.output.max_frequency.end(), templist4);
         }
-        device_data->analog.output.min_amplitude.insert(device_data->analog.output.min_amplitude.end(), templist3);
-        device_data->analog.output.max_amplitude.insert(device_data->analog.output.max_amplitude.end(), templist4);
-        // offset information
-        templist3.clear();
-        templist4.clear();
-        for (int node_index = 0; node_index < device_data->analog.output.node_count[channel_index]; node_index++) {
-            if (FDwfAnalogOutNodeOffsetInfo(handle, channel_index, node_index, &temp3, &temp4) == 0) {
+    }
+
+    // analog IO information
+    if (sections & info.analog_IO) {
+        // channel count
+        if (FDwfAnalogIOChannelCount(handle, &device_data->analog.IO.channel_count) == 0) {
+            check_error(device_data);
+        }
+        for (int channel_index = 0; channel_index < device_data->analog.IO.channel_count; channel_index++) {
+            // channel names and labels
+            char temp1[256];
+            char temp2[256];
+            if (FDwfAnalogIOChannelName(handle, channel_index, temp1, temp2) == 0) {
                 check_error(device_data);
             }
-            templist3.insert(templist3.end(), temp3);
-            templist4.insert(templist4.end(), temp4);
-        }
-        device_data->analog.output.min_offset.insert(device_data->analog.output.min_offset.end(), templist3);
-        device_data->analog.output.max_offset.insert(device_data->analog.output.max_offset.end(), templist4);
-        // frequency information
-        templist3.clear();
-        templist4.clear();
-        for (int node_index = 0; node_index < device_data->analog.output.node_count[channel_index]; node_index++) {
-            if (FDwfAnalogOutNodeFrequencyInfo(handle, channel_index, node_index, &temp3, &temp4) == 0) {
+            device_data->analog.IO.channel_name.insert(device_data->analog.IO.channel_name.end(), std::string(temp1));
+            device_data->analog.IO.channel_label.insert(device_data->analog.IO.channel_label.end(), std::string(temp2));
+            // node count
+            int temp3;
+            if (FDwfAnalogIOChannelInfo(handle, channel_index, &temp3) == 0) {
                 check_error(device_data);
             }
-            templist3.insert(templist3.end(), temp3);
-            templist4.insert(templist4.end(), temp4);
+            device_data->analog.IO.node_count.insert(device_data->analog.IO.node_count.end(), temp3);
+            // node names and units
+            std::vector<std::string> templist1, templist2;
+            for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel_index]; node_index++) {
+                if (FDwfAnalogIOChannelNodeName(handle, channel_index, node_index, temp1, temp2) == 0) {
+                    check_error(device_data);
+                }
+                templist1.insert(templist1.end(), temp1);
+                templist2.insert(templist2.end(), temp2);
+            }
+            device_data->analog.IO.node_name.insert(device_data->analog.IO.node_name.end(), templist1);
+            device_data->analog.IO.node_unit.insert(device_data->analog.IO.node_unit.end(), templist2);
+            // node write info
+            double temp4, temp5;
+            std::vector<int> templist3;
+            std::vector<double> templist4, templist5;
+            for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel_index]; node_index++) {
+                if (FDwfAnalogIOChannelNodeSetInfo(handle, channel_index, node_index, &temp4, &temp5, &temp3) == 0) {
+                    check_error(device_data);
+                }
+                templist3.insert(templist3.end(), temp3);
+                templist4.insert(templist4.end(), temp4);
+                templist5.insert(templist5.end(), temp5);
+            }
+            device_data->analog.IO.min_set_range.insert(device_data->analog.IO.min_set_range.end(), templist4);
+            device_data->analog.IO.max_set_range.insert(device_data->analog.IO.max_set_range.end(), templist5);
+            device_data->analog.IO.set_steps.insert(device_data->analog.IO.set_steps.end(), templist3);
+            // node read info
+            templist3.clear();
+            templist4.clear();
+            templist5.clear();
+            for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel_index]; node_index++) {
+                if (FDwfAnalogIOChannelNodeStatusInfo(handle, channel_index, node_index, &temp4, &temp5, &temp3) == 0) {
+                    check_error(device_data);
+                }
+                templist3.insert(templist3.end(), temp3);
+                templist4.insert(templist4.end(), temp4);
+                templist5.insert(templist5.end(), temp5);
+            }
+            device_data->analog.IO.min_read_range.insert(device_data->analog.IO.min_read_range.end(), templist4);
+            device_data->analog.IO.max_read_range.insert(device_data->analog.IO.max_read_range.end(), templist5);
+            device_data->analog.IO.read_steps.insert(device_data->analog.IO.read_steps.end(), templist3);
         }
-        device_data->analog.output.min_frequency.insert(device_data->analog.output.min_frequency.end(), templist3);
-        device_data->analog.output.max_frequency.insert(device_data->analog.output.max_frequency.end(), templist4);
     }
 
-    // analog IO information
-    // channel count
-    if (FDwfAnalogIOChannelCount(handle, &device_data->analog.IO.channel_count) == 0) {
-        check_error(device_data);
-    }
-    for (int channel_index = 0; channel_index < device_data->analog.IO.channel_count; channel_index++) {
-        // channel names and labels
-        char temp1[256];
-        char temp2[256];
-        if (FDwfAnalogIOChannelName(handle, channel_index, temp1, temp2) == 0) {
+    // digital input information
+    if (sections & info.digital_input) {
+        // channel count
+        if (FDwfDigitalInBitsInfo(handle, &device_data->digital.input.channel_count) == 0) {
             check_error(device_data);
         }
-        device_data->analog.IO.channel_name.insert(device_data->analog.IO.channel_name.end(), std::string(temp1));
-        device_data->analog.IO.channel_label.insert(device_data->analog.IO.channel_label.end(), std::string(temp2));
-        // node count
-        int temp3;
-        if (FDwfAnalogIOChannelInfo(handle, channel_index, &temp3) == 0) {
+        // buffer size
+        if (FDwfDigitalInBufferSizeInfo(handle, &device_data->digital.input.max_buffer_size) == 0) {
             check_error(device_data);
         }
-        device_data->analog.IO.node_count.insert(device_data->analog.IO.node_count.end(), temp3);
-        // node names and units
-        std::vector<std::string> templist1, templist2;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel_index]; node_index++) {
-            if (FDwfAnalogIOChannelNodeName(handle, channel_index, node_index, temp1, temp2) == 0) {
-                check_error(device_data);
-            }
-            templist1.insert(templist1.end(), temp1);
-            templist2.insert(templist2.end(), temp2);
+    }
+
+    // digital output information
+    if (sections & info.digital_output) {
+        // channel count
+        if (FDwfDigitalOutCount(handle, &device_data->digital.output.channel_count) == 0) {
+            check_error(device_data);
         }
-        device_data->analog.IO.node_name.insert(device_data->analog.IO.node_name.end(), templist1);
-        device_data->analog.IO.node_unit.insert(device_data->analog.IO.node_unit.end(), templist2);
-        // node write info
-        double temp4, temp5;
-        std::vector<int> templist3;
-        std::vector<double> templist4, templist5;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel_index]; node_index++) {
-            if (FDwfAnalogIOChannelNodeSetInfo(handle, channel_index, node_index, &temp4, &temp5, &temp3) == 0) {
-                check_error(device_data);
-            }
-            templist3.insert(templist3.end(), temp3);
-            templist4.insert(templist4.end(), temp4);
-            templist5.insert(templist5.end(), temp5);
+        // buffer size
+        unsigned int temp;
+        if (FDwfDigitalOutDataInfo(handle, 0, &temp) == 0) {
+            check_error(device_data);
         }
-        device_data->analog.IO.min_set_range.insert(device_data->analog.IO.min_set_range.end(), templist4);
-        device_data->analog.IO.max_set_range.insert(device_data->analog.IO.max_set_range.end(), templist5);
-        device_data->analog.IO.set_steps.insert(device_data->analog.IO.set_steps.end(), templist3);
-        // node read info
-        templist3.clear();
-        templist4.clear();
-        templist5.clear();
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel_index]; node_index++) {
-            if (FDwfAnalogIOChannelNodeStatusInfo(handle, channel_index, node_index, &temp4, &temp5, &temp3) == 0) {
-                check_error(device_data);
+        device_data->digital.output.max_buffer_size = (int)temp;
+    }
+
+    // resolve the analog IO nodes used by the instruments
+    if (sections & info.analog_IO) {
+        index_nodes(device_data);
+    }
+
+    // update the cache with the new sections
+    device_data->info |= sections;
+    if (device_data->cache != "") {
+        save_info(device_data, device_data->cache);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Device::index_nodes(Data* device_data) {
+    /*
+        resolve the channel and node indices of the analog IO nodes once,
+        so the instruments don't have to search them by name
+    */
+    const char* const system[] = {"System", nullptr};
+    const char* const positive[] = {"V+", "p25V", nullptr};
+    const char* const negative[] = {"V-", "n25V", nullptr};
+    const char* const digital[] = {"VDD", "p6V", nullptr};
+    const char* const dmm[] = {"DMM", nullptr};
+    const char* const dio[] = {"VDD", nullptr};
+
+    find_node(device_data, system, "Temp", &device_data->analog.IO.index.temperature.channel, &device_data->analog.IO.index.temperature.node);
+
+    find_node(device_data, positive, "Enable", &device_data->analog.IO.index.positive_enable.channel, &device_data->analog.IO.index.positive_enable.node);
+    find_node(device_data, positive, "Voltage", &device_data->analog.IO.index.positive_voltage.channel, &device_data->analog.IO.index.positive_voltage.node);
+    find_node(device_data, positive, "Current", &device_data->analog.IO.index.positive_current.channel, &device_data->analog.IO.index.positive_current.node);
+
+    find_node(device_data, negative, "Enable", &device_data->analog.IO.index.negative_enable.channel, &device_data->analog.IO.index.negative_enable.node);
+    find_node(device_data, negative, "Voltage", &device_data->analog.IO.index.negative_voltage.channel, &device_data->analog.IO.index.negative_voltage.node);
+    find_node(device_data, negative, "Current", &device_data->analog.IO.index.negative_current.channel, &device_data->analog.IO.index.negative_current.node);
+
+    find_node(device_data, digital, "Enable", &device_data->analog.IO.index.digital_enable.channel, &device_data->analog.IO.index.digital_enable.node);
+    find_node(device_data, digital, "Voltage", &device_data->analog.IO.index.digital_voltage.channel, &device_data->analog.IO.index.digital_voltage.node);
+    find_node(device_data, digital, "Current", &device_data->analog.IO.index.digital_current.channel, &device_data->analog.IO.index.digital_current.node);
+
+    find_node(device_data, dmm, "Enable", &device_data->analog.IO.index.dmm_enable.channel, &device_data->analog.IO.index.dmm_enable.node);
+    find_node(device_data, dmm, "Mode", &device_data->analog.IO.index.dmm_mode.channel, &device_data->analog.IO.index.dmm_mode.node);
+    find_node(device_data, dmm, "Range", &device_data->analog.IO.index.dmm_range.channel, &device_data->analog.IO.index.dmm_range.node);
+    find_node(device_data, dmm, "Meas", &device_data->analog.IO.index.dmm_meas.channel, &device_data->analog.IO.index.dmm_meas.node);
+    find_node(device_data, dmm, "Raw", &device_data->analog.IO.index.dmm_raw.channel, &device_data->analog.IO.index.dmm_raw.node);
+    find_node(device_data, dmm, "Input", &device_data->analog.IO.index.dmm_input.channel, &device_data->analog.IO.index.dmm_input.node);
+
+    find_node(device_data, dio, "Drive", &device_data->analog.IO.index.dio_drive.channel, &device_data->analog.IO.index.dio_drive.node);
+    find_node(device_data, dio, "DIOPE", &device_data->analog.IO.index.dio_pull_enable.channel, &device_data->analog.IO.index.dio_pull_enable.node);
+    find_node(device_data, dio, "DIOPP", &device_data->analog.IO.index.dio_pull_direction.channel, &device_data->analog.IO.index.dio_pull_direction.node);
+    find_node(device_data, dio, "DINPP", &device_data->analog.IO.index.dio_pull_weak.channel, &device_data->analog.IO.index.dio_pull_weak.node);
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Device::find_node(Data* device_data, const char* const* labels, const char* node, int* channel, int* node_index) {
+    /*
+        find a node of the first analog IO channel with a matching label
+
+        parameters: - device data
+                    - list of accepted channel labels, terminated by nullptr
+                    - node name
+                    - pointer to the channel index, -1 if not found
+                    - pointer to the node index, -1 if not found
+    */
+    *channel = -1;
+    *node_index = -1;
+    for (int channel_index = 0; channel_index < device_data->analog.IO.channel_count && *channel < 0; channel_index++) {
+        for (int label = 0; labels[label] != nullptr; label++) {
+            if (device_data->analog.IO.channel_label[channel_index] == labels[label]) {
+                *channel = channel_index;
+                break;
             }
-            templist3.insert(templist3.end(), temp3);
-            templist4.insert(templist4.end(), temp4);
-            templist5.insert(templist5.end(), temp5);
         }
-        device_data->analog.IO.min_read_range.insert(device_data->analog.IO.min_read_range.end(), templist4);
-        device_data->analog.IO.max_read_range.insert(device_data->analog.IO.max_read_range.end(), templist5);
-        device_data->analog.IO.read_steps.insert(device_data->analog.IO.read_steps.end(), templist3);
     }
+    if (*channel < 0) {
+        return;
+    }
+    for (int index = 0; index < device_data->analog.IO.node_count[*channel]; index++) {
+        if (device_data->analog.IO.node_name[*channel][index] == node) {
+            *node_index = index;
+            break;
+        }
+    }
+    return;
+}
 
-    // digital input information
-    // channel count
-    if (FDwfDigitalInBitsInfo(handle, &device_data->digital.input.channel_count) == 0) {
-        check_error(device_data);
+/* ----------------------------------------------------- */
+
+std::string wf::Device::cache_path(int device_id, int device_revision, int config, std::string version) {
+    /*
+        get the name of the device information cache file
+
+        parameters: - device id
+                    - device revision
+                    - configuration
+                    - WaveForms version
+
+        returns:    - path of the cache file
+    */
+    const char *directory = getenv("WF_SDK_CACHE");
+    const char *candidates[] = {"TMPDIR", "TEMP", "TMP"};
+    for (int index = 0; index < 3 && directory == nullptr; index++) {
+        directory = getenv(candidates[index]);
     }
-    // buffer size
-    if (FDwfDigitalInBufferSizeInfo(handle, &device_data->digital.input.max_buffer_size) == 0) {
-        check_error(device_data);
+    std::string path = directory != nullptr ? std::string(directory) : std::string("/tmp");
+    if (path != "" && path[path.size() - 1] != '/' && path[path.size() - 1] != '\\') {
+        path += "/";
     }
+    return path + "wf_sdk_" + std::to_string(device_id) + "_" + std::to_string(device_revision) + "_" + std::to_string(config) + "_" + version + ".cache";
+}
 
-    // digital output information
-    // channel count
-    if (FDwfDigitalOutCount(handle, &device_data->digital.output.channel_count) == 0) {
-        check_error(device_data);
+/* ----------------------------------------------------- */
+
+bool wf::Device::load_info(Data* device_data, std::string path) {
+    /*
+        load the device information sections saved in the cache with one read
+
+        parameters: - device data
+                    - path of the cache file
+
+        returns:    - True on success, False if the file is missing or invalid
+    */
+    std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
     }
-    // buffer size
-    unsigned int temp;
-    if (FDwfDigitalOutDataInfo(handle, 0, &temp) == 0) {
-        check_error(device_data);
+    std::streamsize size = file.tellg();
+    if (size <= 0) {
+        return false;
+    }
+    std::string buffer(size_t(size), '\0');
+    file.seekg(0);
+    if (!file.read(&buffer[0], size)) {
+        return false;
+    }
+
+    // check the format
+    size_t position = 0;
+    std::string magic;
+    int format = 0;
+    if (!get(buffer, position, magic) || magic != "WF_SDK_INFO" || !get(buffer, position, format) || format != 2) {
+        return false;
+    }
+
+    // decode into a copy, the device data is only changed if everything is valid
+    Data saved;
+    bool valid = get(buffer, position, saved.version) && get(buffer, position, saved.info);
+
+    valid = valid && get(buffer, position, saved.analog.input.channel_count);
+    valid = valid && get(buffer, position, saved.analog.input.max_buffer_size);
+    valid = valid && get(buffer, position, saved.analog.input.max_resolution);
+    valid = valid && get(buffer, position, saved.analog.input.min_range);
+    valid = valid && get(buffer, position, saved.analog.input.max_range);
+    valid = valid && get(buffer, position, saved.analog.input.steps_range);
+    valid = valid && get(buffer, position, saved.analog.input.min_offset);
+    valid = valid && get(buffer, position, saved.analog.input.max_offset);
+    valid = valid && get(buffer, position, saved.analog.input.steps_offset);
+
+    valid = valid && get(buffer, position, saved.analog.output.channel_count);
+    valid = valid && get(buffer, position, saved.analog.output.node_count);
+    valid = valid && get(buffer, position, saved.analog.output.node_type);
+    valid = valid && get(buffer, position, saved.analog.output.max_buffer_size);
+    valid = valid && get(buffer, position, saved.analog.output.min_amplitude);
+    valid = valid && get(buffer, position, saved.analog.output.max_amplitude);
+    valid = valid && get(buffer, position, saved.analog.output.min_offset);
+    valid = valid && get(buffer, position, saved.analog.output.max_offset);
+    valid = valid && get(buffer, position, saved.analog.output.min_frequency);
+    valid = valid && get(buffer, position, saved.analog.output.max_frequency);
+
+    valid = valid && get(buffer, position, saved.analog.IO.channel_count);
+    valid = valid && get(buffer, position, saved.analog.IO.node_count);
+    valid = valid && get(buffer, position, saved.analog.IO.channel_name);
+    valid = valid && get(buffer, position, saved.analog.IO.channel_label);
+    valid = valid && get(buffer, position, saved.analog.IO.node_name);
+    valid = valid && get(buffer, position, saved.analog.IO.node_unit);
+    valid = valid && get(buffer, position, saved.analog.IO.min_set_range);
+    valid = valid && get(buffer, position, saved.analog.IO.max_set_range);
+    valid = valid && get(buffer, position, saved.analog.IO.min_read_range);
+    valid = valid && get(buffer, position, saved.analog.IO.max_read_range);
+    valid = valid && get(buffer, position, saved.analog.IO.set_steps);
+    valid = valid && get(buffer, position, saved.analog.IO.read_steps);
+
+    valid = valid && get(buffer, position, saved.digital.input.channel_count);
+    valid = valid && get(buffer, position, saved.digital.input.max_buffer_size);
+    valid = valid && get(buffer, position, saved.digital.output.channel_count);
+    valid = valid && get(buffer, position, saved.digital.output.max_buffer_size);
+
+    // the lists must match the channel counts
+    valid = valid && position == buffer.size();
+    valid = valid && int(saved.analog.output.node_count.size()) == saved.analog.output.channel_count;
+    valid = valid && int(saved.analog.IO.node_count.size()) == saved.analog.IO.channel_count;
+    if (!valid) {
+        return false;
+    }
+
+    device_data->info = saved.info;
+    device_data->analog = saved.analog;
+    device_data->digital = saved.digital;
+    if (device_data->info & info.analog_IO) {
+        index_nodes(device_data);
+    }
+    return true;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Device::save_info(Data* device_data, std::string path) {
+    /*
+        save the device information to the cache, failures are ignored
+
+        parameters: - device data
+                    - path of the cache file
+    */
+    std::string buffer;
+    put(buffer, std::string("WF_SDK_INFO"));
+    put(buffer, 2);
+    put(buffer, device_data->version);
+    put(buffer, device_data->info);
+
+    put(buffer, device_data->analog.input.channel_count);
+    put(buffer, device_data->analog.input.max_buffer_size);
+    put(buffer, device_data->analog.input.max_resolution);
+    put(buffer, device_data->analog.input.min_range);
+    put(buffer, device_data->analog.input.max_range);
+    put(buffer, device_data->analog.input.steps_range);
+    put(buffer, device_data->analog.input.min_offset);
+    put(buffer, device_data->analog.input.max_offset);
+    put(buffer, device_data->analog.input.steps_offset);
+
+    put(buffer, device_data->analog.output.channel_count);
+    put(buffer, device_data->analog.output.node_count);
+    put(buffer, device_data->analog.output.node_type);
+    put(buffer, device_data->analog.output.max_buffer_size);
+    put(buffer, device_data->analog.output.min_amplitude);
+    put(buffer, device_data->analog.output.max_amplitude);
+    put(buffer, device_data->analog.output.min_offset);
+    put(buffer, device_data->analog.output.max_offset);
+    put(buffer, device_data->analog.output.min_frequency);
+    put(buffer, device_data->analog.output.max_frequency);
+
+    put(buffer, device_data->analog.IO.channel_count);
+    put(buffer, device_data->analog.IO.node_count);
+    put(buffer, device_data->analog.IO.channel_name);
+    put(buffer, device_data->analog.IO.channel_label);
+    put(buffer, device_data->analog.IO.node_name);
+    put(buffer, device_data->analog.IO.node_unit);
+    put(buffer, device_data->analog.IO.min_set_range);
+    put(buffer, device_data->analog.IO.max_set_range);
+    put(buffer, device_data->analog.IO.min_read_range);
+    put(buffer, device_data->analog.IO.max_read_range);
+    put(buffer, device_data->analog.IO.set_steps);
+    put(buffer, device_data->analog.IO.read_steps);
+
+    put(buffer, device_data->digital.input.channel_count);
+    put(buffer, device_data->digital.input.max_buffer_size);
+    put(buffer, device_data->digital.output.channel_count);
+    put(buffer, device_data->digital.output.max_buffer_size);
+
+    // write to a temporary file first, so other processes never read a partial file,
+    // the name is unique for every process and every device opened by it
+#ifdef _WIN32
+    int process = _getpid();
+#else
+    int process = int(getpid());
+#endif
+    std::string temporary = path + "." + std::to_string(process) + "_" + std::to_string(device_data->handle) + ".tmp";
+    std::ofstream file(temporary.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return;
+    }
+    file.write(buffer.data(), buffer.size());
+    file.close();
+    if (!file) {
+        std::remove(temporary.c_str());
+        return;
+    }
+    std::remove(path.c_str());
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
     }
-    device_data->digital.output.max_buffer_size = (int)temp;
+    return;
+}
+
+/* ----------------------------------------------------- */
 
+void wf::Device::put(std::string &buffer, int value) {
+    buffer.append((const char *)&value, sizeof(value));
     return;
 }
+
+void wf::Device::put(std::string &buffer, double value) {
+    buffer.append((const char *)&value, sizeof(value));
+    return;
+}
+
+void wf::Device::put(std::string &buffer, const std::string &value) {
+    put(buffer, int(value.size()));
+    buffer.append(value);
+    return;
+}
+
+template <typename T>
+void wf::Device::put(std::string &buffer, const std::vector<T> &values) {
+    put(buffer, int(values.size()));
+    for (size_t index = 0; index < values.size(); index++) {
+        put(buffer, values[index]);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+bool wf::Device::get(const std::string &buffer, size_t &position, int &value) {
+    if (position + sizeof(value) > buffer.size()) {
+        return false;
+    }
+    memcpy(&value, buffer.data() + position, sizeof(value));
+    position += sizeof(value);
+    return true;
+}
+
+bool wf::Device::get(const std::string &buffer, size_t &position, double &value) {
+    if (position + sizeof(value) > buffer.size()) {
+        return false;
+    }
+    memcpy(&value, buffer.data() + position, sizeof(value));
+    position += sizeof(value);
+    return true;
+}
+
+bool wf::Device::get(const std::string &buffer, size_t &position, std::string &value) {
+    int length = 0;
+    if (!get(buffer, position, length) || length < 0 || position + length > buffer.size()) {
+        return false;
+    }
+    value.assign(buffer, position, length);
+    position += length;
+    return true;
+}
+
+template <typename T>
+bool wf::Device::get(const std::string &buffer, size_t &position, std::vector<T> &values) {
+    int length = 0;
+    if (!get(buffer, position, length) || length < 0 || size_t(length) > buffer.size() - position) {
+        return false;
+    }
+    values.resize(length);
+    for (int index = 0; index < length; index++) {
+        if (!get(buffer, position, values[index])) {
+            return false;
+        }
+    }
+    return true;
+}
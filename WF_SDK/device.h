@@ -1,4 +1,4 @@
-/* DEVICE CONTROL FUNCTIONS: open, check_error, close, temperature */
+/* DEVICE CONTROL FUNCTIONS: open, open_index, get_info, check_error, last_status, check_status, close, temperature */
 
 /* include the necessary libraries */
 #include <string>
@@ -6,7 +6,11 @@
 #include <map>
 #include <iostream>
 #include <vector>
+#include <functional>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include "dwf.h"
 
 #ifndef WF_DEVICE
@@ -43,6 +47,66 @@ class Warning {
         }
 };
 
+class Status {
+    /* result of the non-throwing functions, the message is only built when it is requested */
+    public:
+        enum Code { ok = 0, error, nak, parity, overflow, lockup };
+        Code code = ok;
+        int index = 0;  // DWFERC for errors, byte index for NAK and parity errors
+        const char *function = "";
+        const char *file = "";
+
+        Status(Code code = ok, int index = 0, const char *function = "", const char *file = "") : code(code), index(index), function(function), file(file) {}
+        explicit operator bool(void) const {
+            return code == ok;
+        }
+
+        std::string instrument(void) const {
+            // the file name without path and extension, protocol warnings keep the "protocol/" prefix
+            std::string name = file;
+            std::string prefix = "";
+            size_t position = name.find_last_of("/\\");
+            if (position != std::string::npos) {
+                std::string folder = name.substr(0, position);
+                size_t parent = folder.find_last_of("/\\");
+                if (parent != std::string::npos) {
+                    folder = folder.substr(parent + 1);
+                }
+                if (code != error && folder == "protocol") {
+                    prefix = "protocol/";
+                }
+                name = name.substr(position + 1);
+            }
+            position = name.find('.');
+            if (position != std::string::npos) {
+                name = name.substr(0, position);
+            }
+            return prefix + name;
+        }
+
+        std::string message(void) const {
+            // SDK errors have to be checked before the next SDK call
+            if (code == error) {
+                char err_msg[512];
+                FDwfGetLastErrorMsg(err_msg);
+                return std::string(err_msg);
+            }
+            else if (code == nak) {
+                return "NAK: index " + std::to_string(index);
+            }
+            else if (code == parity) {
+                return "Parity error: index " + std::to_string(index);
+            }
+            else if (code == overflow) {
+                return "Buffer overflow";
+            }
+            else if (code == lockup) {
+                return "I2C bus lockup";
+            }
+            return "";
+        }
+};
+
 class Device {
     // private class definitions
 private:
@@ -109,6 +173,67 @@ public:
             };
             class IO_data {
             public:
+                class node_index {
+                public:
+                    int channel = -1;
+                    int node = -1;
+                    node_index& operator=(const node_index& data) {
+                        if (this != &data) {
+                            channel = data.channel;
+                            node = data.node;
+                        }
+                        return *this;
+                    }
+                };
+                class index_data {
+                public:
+                    node_index temperature;
+                    node_index positive_enable;
+                    node_index positive_voltage;
+                    node_index positive_current;
+                    node_index negative_enable;
+                    node_index negative_voltage;
+                    node_index negative_current;
+                    node_index digital_enable;
+                    node_index digital_voltage;
+                    node_index digital_current;
+                    node_index dmm_enable;
+                    node_index dmm_mode;
+                    node_index dmm_range;
+                    node_index dmm_meas;
+                    node_index dmm_raw;
+                    node_index dmm_input;
+                    node_index dio_drive;
+                    node_index dio_pull_enable;
+                    node_index dio_pull_direction;
+                    node_index dio_pull_weak;
+                    index_data& operator=(const index_data& data) {
+                        if (this != &data) {
+                            temperature = data.temperature;
+                            positive_enable = data.positive_enable;
+                            positive_voltage = data.positive_voltage;
+                            positive_current = data.positive_current;
+                            negative_enable = data.negative_enable;
+                            negative_voltage = data.negative_voltage;
+                            negative_current = data.negative_current;
+                            digital_enable = data.digital_enable;
+                            digital_voltage = data.digital_voltage;
+                            digital_current = data.digital_current;
+                            dmm_enable = data.dmm_enable;
+                            dmm_mode = data.dmm_mode;
+                            dmm_range = data.dmm_range;
+                            dmm_meas = data.dmm_meas;
+                            dmm_raw = data.dmm_raw;
+                            dmm_input = data.dmm_input;
+                            dio_drive = data.dio_drive;
+                            dio_pull_enable = data.dio_pull_enable;
+                            dio_pull_direction = data.dio_pull_direction;
+                            dio_pull_weak = data.dio_pull_weak;
+                        }
+                        return *this;
+                    }
+                };
+
                 int channel_count = 0;
                 std::vector<int> node_count;
                 std::vector<std::string> channel_name;
@@ -121,6 +246,7 @@ public:
                 std::vector<std::vector<double>> max_read_range;
                 std::vector<std::vector<int>> set_steps;
                 std::vector<std::vector<int>> read_steps;
+                index_data index;
                 IO_data& operator=(const IO_data& data) {
                     if (this != &data) {
                         channel_count = data.channel_count;
@@ -135,6 +261,7 @@ public:
                         max_read_range = data.max_read_range;
                         set_steps = data.set_steps;
                         read_steps = data.read_steps;
+                        index = data.index;
                     }
                     return *this;
                 }
@@ -198,33 +325,72 @@ public:
         HDWF handle = 0;
         std::string name = "";
         std::string version = "";
+        int info = 0;
+        std::string cache = "";
         Error error;
         Warning warning;
         analog_data analog;
         digital_data digital;
+        int analog_IO_generation = 0;  // incremented by every analog IO reset, invalidates the cached settings
+        std::map<void*, std::function<void(void)>> engines;    // background threads stopped by close, by owner
 
         Data& operator=(const Data& data) {
             if (this != &data) {
                 handle = data.handle;
                 name = data.name;
                 version = data.version;
+                info = data.info;
+                cache = data.cache;
                 error = data.error;
                 warning = data.warning;
                 analog = data.analog;
                 digital = data.digital;
+                analog_IO_generation = data.analog_IO_generation;
             }
             return *this;
         }
     };
 
+    class Info {
+        /* device information sections */
+        public:
+            const int analog_input = 1;
+            const int analog_output = 2;
+            const int analog_IO = 4;
+            const int digital_input = 8;
+            const int digital_output = 16;
+            const int all = 31;
+    };
+
     // private function definitions
 private:
-    void get_info(Data* device_data);
+    void setup(Data* device_data, int index, int config, bool use_cache);
+    void index_nodes(Data* device_data);
+    void find_node(Data* device_data, const char* const* labels, const char* node, int* channel, int* node_index);
+    std::string cache_path(int device_id, int device_revision, int config, std::string version);
+    bool load_info(Data* device_data, std::string path);
+    void save_info(Data* device_data, std::string path);
+    void put(std::string &buffer, int value);
+    void put(std::string &buffer, double value);
+    void put(std::string &buffer, const std::string &value);
+    template <typename T>
+    void put(std::string &buffer, const std::vector<T> &values);
+    bool get(const std::string &buffer, size_t &position, int &value);
+    bool get(const std::string &buffer, size_t &position, double &value);
+    bool get(const std::string &buffer, size_t &position, std::string &value);
+    template <typename T>
+    bool get(const std::string &buffer, size_t &position, std::vector<T> &values);
 
     // public function definitions
 public:
-    Data* open(std::string device = "", int config = 0);
-    void check_error(Data *device_data, const char *caller = __builtin_FUNCTION(), const char *file = __FILE__);
+    Info info;
+    Data* open(std::string device = "", int config = 0, bool use_cache = true);
+    Data* open_index(int index, int config = 0, bool use_cache = true);
+    void get_info(Data* device_data, int sections);
+    std::map<std::string, int> names(void);
+    void check_error(Data *device_data, const char *caller = __builtin_FUNCTION(), const char *file = __builtin_FILE());
+    Status last_status(const char *caller = __builtin_FUNCTION(), const char *file = __builtin_FILE());
+    void check_status(Data *device_data, const Status &status);
     void close(Data *device_data);
     double temperature(Data *device_data);
 } device;
@@ -1,4 +1,4 @@
-/* DIGITAL MULTIMETER CONTROL FUNCTIONS: open, measure, close */
+/* DIGITAL MULTIMETER CONTROL FUNCTIONS: open, configure, measure, close */
 
 /* include the header */
 #include "dmm.h"
@@ -9,35 +9,25 @@ void wf::DMM::open(Device::Data *device_data) {
     /*
         initialize the digital multimeter
     */
+    // the DMM nodes are resolved with the analog IO information
+    device.get_info(device_data, device.info.analog_IO);
+    auto &index = device_data->analog.IO.index;
+    data.channel = index.dmm_enable.channel;
+    data.nodes.enable = index.dmm_enable.node;
+    data.nodes.mode = index.dmm_mode.node;
+    data.nodes.range = index.dmm_range.node;
+    data.nodes.meas = index.dmm_meas.node;
+    data.nodes.raw = index.dmm_raw.node;
+    data.nodes.input = index.dmm_input.node;
+
+    // nothing is configured yet
+    data.mode = -1;
+    data.range = -1;
+    data.high_impedance = -1;
+    data.device = device_data;
+    data.generation = device_data->analog_IO_generation;
+
     // enable the DMM
-    for (int channel_index = 0; channel_index < device_data->analog.IO.channel_count; channel_index++) {
-        if (device_data->analog.IO.channel_label[channel_index] == std::string("DMM")) {
-            data.channel = channel_index;
-            break;
-        }
-    }
-    if (data.channel >= 0) {
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[data.channel]; node_index++) {
-            if (device_data->analog.IO.node_name[data.channel][node_index] == std::string("Enable")) {
-                data.nodes.enable = node_index;
-            }
-            else if (device_data->analog.IO.node_name[data.channel][node_index] == std::string("Mode")) {
-                data.nodes.mode = node_index;
-            }
-            else if (device_data->analog.IO.node_name[data.channel][node_index] == std::string("Range")) {
-                data.nodes.range = node_index;
-            }
-            else if (device_data->analog.IO.node_name[data.channel][node_index] == std::string("Meas")) {
-                data.nodes.meas = node_index;
-            }
-            else if (device_data->analog.IO.node_name[data.channel][node_index] == std::string("Raw")) {
-                data.nodes.raw = node_index;
-            }
-            else if (device_data->analog.IO.node_name[data.channel][node_index] == std::string("Input")) {
-                data.nodes.input = node_index;
-            }
-        }
-    }
     if (data.channel >= 0 && data.nodes.enable >= 0) {
         if (FDwfAnalogIOChannelNodeSet(device_data->handle, data.channel, data.nodes.enable, double(1.0)) == 0) {
             device.check_error(device_data);
@@ -48,51 +38,75 @@ void wf::DMM::open(Device::Data *device_data) {
 
 /* ----------------------------------------------------- */
 
-double wf::DMM::measure(Device::Data *device_data, DwfDmm mode, double range, bool high_impedance) {
+void wf::DMM::configure(Device::Data *device_data, DwfDmm mode, double range, bool high_impedance) {
     /*
-        measure a voltage/current/resistance/continuity/temperature
+        set the measurement mode, only the settings which differ from the current ones are written
 
         parameters: - device data
                     - mode: "ac/dc_voltage", "ac/dc_low/high_current", "resistance", "continuity", "diode", "temperature"
                     - range: voltage/current/resistance/temperature range, 0 means auto, default is auto
                     - high_impedance: input impedance for DC voltage measurement, False means 10MΩ, True means 10GΩ, default is 10MΩ
-        
-        returns:    - the measured value in V/A/Ω/°C, or -1 on error
     */
+    // the cache is lost if the analog IO was reset or the settings were written to another device
+    if (data.device != device_data || data.generation != device_data->analog_IO_generation) {
+        data.mode = -1;
+        data.range = -1;
+        data.high_impedance = -1;
+        data.device = device_data;
+        data.generation = device_data->analog_IO_generation;
+    }
+
     // set input impedance
-    if (data.channel >= 0 && data.nodes.input >= 0) {
-        if (high_impedance == true) {
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, data.channel, data.nodes.input, double(1.0)) == 0) {
-                device.check_error(device_data);
-            }
-        }
-        else {
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, data.channel, data.nodes.input, double(0.0)) == 0) {
-                device.check_error(device_data);
-            }
+    if (data.channel >= 0 && data.nodes.input >= 0 && data.high_impedance != int(high_impedance)) {
+        if (FDwfAnalogIOChannelNodeSet(device_data->handle, data.channel, data.nodes.input, high_impedance ? double(1.0) : double(0.0)) == 0) {
+            device.check_error(device_data);
         }
+        data.high_impedance = int(high_impedance);
     }
 
     // set mode
-    if (data.channel >= 0 && data.nodes.mode >= 0) {
+    if (data.channel >= 0 && data.nodes.mode >= 0 && data.mode != mode) {
         if (FDwfAnalogIOChannelNodeSet(device_data->handle, data.channel, data.nodes.mode, mode) == 0) {
             device.check_error(device_data);
         }
+        data.mode = mode;
     }
-        
+
     // set range
-    if (data.channel >= 0 && data.nodes.range >= 0) {
+    if (data.channel >= 0 && data.nodes.range >= 0 && data.range != range) {
         if (FDwfAnalogIOChannelNodeSet(device_data->handle, data.channel, data.nodes.range, range) == 0) {
             device.check_error(device_data);
         }
+        data.range = range;
     }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+double wf::DMM::measure(Device::Data *device_data, DwfDmm mode, double range, bool high_impedance) {
+    /*
+        measure a voltage/current/resistance/continuity/temperature
+
+        parameters: - device data
+                    - mode: "ac/dc_voltage", "ac/dc_low/high_current", "resistance", "continuity", "diode", "temperature"
+                    - range: voltage/current/resistance/temperature range, 0 means auto, default is auto
+                    - high_impedance: input impedance for DC voltage measurement, False means 10MΩ, True means 10GΩ, default is 10MΩ
+        
+        returns:    - the measured value in V/A/Ω/°C, or -1 on error
+                      (data.time is the timestamp of the reading, see tools.timestamp)
+    */
+    // set up the measurement, unchanged settings are not written again
+    configure(device_data, mode, range, high_impedance);
 
-    // fetch analog I/O status
+    // fetch analog I/O status, the reading is stamped with the middle of the transfer
+    long long start = tools.timestamp();
     if (FDwfAnalogIOStatus(device_data->handle) == 0) {
         // signal error
         device.check_error(device_data);
         return double(-1.0);
     }
+    data.time = start + (tools.timestamp() - start) / 2;
 
     // get reading
     double measurement = 0;
@@ -120,5 +134,9 @@ void wf::DMM::close(Device::Data *device_data) {
     if (FDwfAnalogIOReset(device_data->handle) == 0) {
         device.check_error(device_data);
     }
+    device_data->analog_IO_generation++;
+    data.mode = -1;
+    data.range = -1;
+    data.high_impedance = -1;
     return;
 }
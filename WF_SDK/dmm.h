@@ -1,9 +1,10 @@
-/* DIGITAL MULTIMETER CONTROL FUNCTIONS: open, measure, close */
+/* DIGITAL MULTIMETER CONTROL FUNCTIONS: open, configure, measure, close */
 
 /* include the necessary libraries */
 #include <string>
 #include "dwf.h"
 #include "device.h"
+#include "tools.h"
 
 #ifndef WF_DMM
 #define WF_DMM
@@ -50,11 +51,21 @@ class DMM {
             public:
                 int channel = -1;
                 DwfDmm mode = -1;
+                double range = -1;
+                int high_impedance = -1;
+                Device::Data *device = nullptr;     // the settings above are cached for this device
+                int generation = -1;                // and this analog IO generation
+                long long time = 0;
                 Nodes nodes;
                 Data& operator=(const Data &data) {
                     if (this != &data) {
                         channel = data.channel;
                         mode = data.mode;
+                        range = data.range;
+                        high_impedance = data.high_impedance;
+                        device = data.device;
+                        generation = data.generation;
+                        time = data.time;
                         nodes = data.nodes;
                     }
                     return *this;
@@ -64,6 +75,7 @@ class DMM {
         Mode mode;
         Data data;
         void open(Device::Data *device_data);
+        void configure(Device::Data *device_data, DwfDmm mode, double range = 0, bool high_impedance = false);
         double measure(Device::Data *device_data, DwfDmm mode, double range = 0, bool high_impedance = false);
         void close(Device::Data *device_data);
 } dmm;
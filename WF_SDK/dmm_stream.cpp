@@ -0,0 +1,175 @@
+/* DIGITAL MULTIMETER STREAMING FUNCTIONS: start, read, status, stop */
+
+/* include the header */
+#include "dmm_stream.h"
+#include <chrono>
+#include <cmath>
+
+/* ----------------------------------------------------- */
+
+void wf::DMM_Stream::start(Device::Data *device_data, DwfDmm mode, double range, bool high_impedance, double rate, int history_size) {
+    /*
+        configure the DMM once and collect readings on a background thread
+
+        parameters: - device data
+                    - mode: "ac/dc_voltage", "ac/dc_low/high_current", "resistance", "continuity", "diode", "temperature"
+                    - range: voltage/current/resistance/temperature range, 0 means auto, default is auto
+                    - high_impedance: input impedance for DC voltage measurement, False means 10MΩ, True means 10GΩ, default is 10MΩ
+                    - rate - reading frequency in Hz, default is 0 (as fast as possible)
+                    - history_size - number of readings kept until read, default is 65536
+    */
+    stop(device_data);
+
+    // enable the DMM of this device and write the settings once
+    dmm.open(device_data);
+    dmm.configure(device_data, mode, range, high_impedance);
+    handle = device_data->handle;
+    channel = dmm.data.channel;
+    node = dmm.data.nodes.meas;
+    this->rate = rate;
+    if (channel < 0 || node < 0) {
+        device_data->error.instrument = "dmm_stream";
+        device_data->error.function = "start";
+        device_data->error.message = "There is no DMM on this device";
+        throw device_data->error;
+    }
+
+    history.resize(history_size);
+    statistics = Accumulator();
+    last = 0;
+    data = Data();
+    data.rate = rate;
+    failed = false;
+    running = true;
+    sampler = std::thread(&DMM_Stream::sample, this);
+
+    // device.close stops the sampler before the handle is closed
+    owner = device_data;
+    owner->engines[this] = [this]() {
+        stop(nullptr);
+    };
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+std::vector<wf::DMM_Stream::Sample> wf::DMM_Stream::read(Device::Data *device_data, int max_count) {
+    /*
+        take the stored readings
+
+        parameters: - device data
+                    - max_count - maximum number of readings, default is 0 (every stored reading)
+
+        returns:    - list of readings: time (steady clock nanoseconds) and value in V/A/Ω/°C
+    */
+    if (failed) {
+        device_data->error = error;
+        throw device_data->error;
+    }
+    size_t count = history.size();
+    if (max_count > 0 && size_t(max_count) < count) {
+        count = max_count;
+    }
+    std::vector<Sample> result(count);
+    result.resize(history.pop(result.data(), count));
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+wf::DMM_Stream::Data wf::DMM_Stream::status(void) {
+    /*
+        returns:    - the statistics of every reading since start: last, min, max, mean, standard deviation,
+                      drift (linear trend in units/s), the number of readings and the readings dropped
+                      because the history was full
+    */
+    std::lock_guard<std::mutex> guard(lock);
+    data.rate = rate;
+    data.samples = statistics.count;
+    data.dropped_samples = history.drop_count();
+    data.last = last;
+    data.min = statistics.min;
+    data.max = statistics.max;
+    data.mean = statistics.mean;
+    data.stddev = statistics.count > 1 ? sqrt(statistics.squares / (statistics.count - 1)) : 0;
+    data.drift = statistics.squares_time > 0 ? statistics.covariance / statistics.squares_time : 0;
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::DMM_Stream::stop(Device::Data*) {
+    /*
+        stop the sampler thread, the DMM stays configured
+    */
+    running = false;
+    if (sampler.joinable()) {
+        sampler.join();
+    }
+    if (owner != nullptr) {
+        owner->engines.erase(this);
+        owner = nullptr;
+    }
+    status();
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::DMM_Stream::sample(void) {
+    /*
+        sampler thread: one status read and one node read per reading
+    */
+    typedef std::chrono::steady_clock clock;
+    clock::time_point start = clock::now();
+    clock::time_point next = start;
+    std::chrono::nanoseconds period(rate > 0 ? (long long)(1e09 / rate) : 0);
+
+    while (running) {
+        Sample current;
+        if (FDwfAnalogIOStatus(handle) == 0 || FDwfAnalogIOChannelNodeStatus(handle, channel, node, &current.value) == 0) {
+            char message[512];
+            FDwfGetLastErrorMsg(message);
+            error.instrument = "dmm_stream";
+            error.function = "sample";
+            error.message = message;
+            failed = true;
+            break;
+        }
+        clock::time_point now = clock::now();
+        current.time = tools.timestamp();
+        history.push(current);
+
+        // update the online statistics
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            Accumulator &stats = statistics;
+            double time = std::chrono::duration<double>(now - start).count();
+            stats.count++;
+            if (stats.count == 1 || current.value < stats.min) {
+                stats.min = current.value;
+            }
+            if (stats.count == 1 || current.value > stats.max) {
+                stats.max = current.value;
+            }
+            double delta = current.value - stats.mean;
+            double delta_time = time - stats.mean_time;
+            stats.mean += delta / stats.count;
+            stats.mean_time += delta_time / stats.count;
+            stats.squares += delta * (current.value - stats.mean);
+            stats.squares_time += delta_time * (time - stats.mean_time);
+            stats.covariance += delta_time * (current.value - stats.mean);
+            last = current.value;
+        }
+
+        // wait for the next reading
+        if (rate > 0) {
+            next += period;
+            if (now > next) {
+                next = now;
+            }
+            std::this_thread::sleep_until(next);
+        }
+    }
+    return;
+}
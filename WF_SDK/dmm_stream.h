@@ -0,0 +1,94 @@
+/* DIGITAL MULTIMETER STREAMING FUNCTIONS: start, read, status, stop */
+
+/* include the necessary libraries */
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include "dwf.h"
+#include "device.h"
+#include "tools.h"
+#include "dmm.h"
+#include "ring.h"
+
+#ifndef WF_DMM_STREAM
+#define WF_DMM_STREAM
+namespace wf {
+
+class DMM_Stream {
+    public:
+        class Sample {
+            public:
+                long long time = 0;
+                double value = 0;
+        };
+
+        class Data {
+            public:
+                double rate = 0;
+                unsigned long long samples = 0;
+                unsigned long long dropped_samples = 0;
+                double last = 0;
+                double min = 0;
+                double max = 0;
+                double mean = 0;
+                double stddev = 0;
+                double drift = 0;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        rate = data.rate;
+                        samples = data.samples;
+                        dropped_samples = data.dropped_samples;
+                        last = data.last;
+                        min = data.min;
+                        max = data.max;
+                        mean = data.mean;
+                        stddev = data.stddev;
+                        drift = data.drift;
+                    }
+                    return *this;
+                }
+        };
+
+    private:
+        class Accumulator {
+            /* online statistics (Welford) */
+            public:
+                unsigned long long count = 0;
+                double min = 0;
+                double max = 0;
+                double mean = 0;
+                double squares = 0;
+                double mean_time = 0;
+                double squares_time = 0;
+                double covariance = 0;
+        };
+
+        Ring<Sample> history;
+        std::thread sampler;
+        std::mutex lock;
+        std::atomic<bool> running{false};
+        std::atomic<bool> failed{false};
+        Error error;
+        HDWF handle = 0;
+        Device::Data *owner = nullptr;
+        int channel = -1;
+        int node = -1;
+        double rate = 0;
+        double last = 0;
+        Accumulator statistics;
+        void sample(void);
+
+    public:
+        Data data;
+        void start(Device::Data *device_data, DwfDmm mode, double range = 0, bool high_impedance = false, double rate = 0, int history_size = 1 << 16);
+        std::vector<Sample> read(Device::Data *device_data, int max_count = 0);
+        Data status(void);
+        void stop(Device::Data *device_data);
+        ~DMM_Stream() {
+            stop(nullptr);
+        }
+} dmm_stream;
+
+}
+#endif
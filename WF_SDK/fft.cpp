@@ -0,0 +1,426 @@
+/* FFT ENGINE FUNCTIONS: transform, inverse, real, zoom, window */
+
+/* include the header */
+#include "fft.h"
+#include "tools.h"
+
+/* ----------------------------------------------------- */
+
+void wf::FFT::transform(std::complex<double> *data, int length) {
+    /*
+        in-place discrete Fourier transform of any length
+
+        parameters: - data - complex samples, replaced by the spectrum
+                    - length - number of samples
+    */
+    if (length > 1) {
+        execute(data, *get_plan(length), false);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::FFT::inverse(std::complex<double> *data, int length) {
+    /*
+        in-place inverse discrete Fourier transform of any length, scaled by 1/length
+
+        parameters: - data - complex spectrum, replaced by the samples
+                    - length - number of samples
+    */
+    if (length > 1) {
+        execute(data, *get_plan(length), true);
+        double scale = 1.0 / length;
+        for (int index = 0; index < length; index++) {
+            data[index] *= scale;
+        }
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::FFT::real(const double *input, int length, std::complex<double> *output) {
+    /*
+        transform of real samples
+
+        parameters: - input - real samples
+                    - length - number of samples
+                    - output - buffer for length / 2 + 1 complex bins, from DC to the Nyquist frequency
+    */
+    if (length < 2) {
+        if (length == 1) {
+            output[0] = input[0];
+        }
+        return;
+    }
+
+    if (length % 2 != 0) {
+        // odd lengths use a complex transform
+        thread_local std::vector<std::complex<double>> work;
+        work.resize(length);
+        for (int index = 0; index < length; index++) {
+            work[index] = input[index];
+        }
+        execute(work.data(), *get_plan(length), false);
+        for (int index = 0; index <= length / 2; index++) {
+            output[index] = work[index];
+        }
+        return;
+    }
+
+    // pack the even and odd samples into a half length complex transform, done in the output buffer
+    int half = length / 2;
+    const Plan &plan = *get_plan(half);
+    for (int index = 0; index < half; index++) {
+        output[index] = std::complex<double>(input[2 * index], input[2 * index + 1]);
+    }
+    execute(output, plan, false);
+
+    // split the result into the spectrum of the real signal, bins k and half - k are computed together
+    std::complex<double> first = output[0];
+    output[0] = std::complex<double>(first.real() + first.imag(), 0);
+    output[half] = std::complex<double>(first.real() - first.imag(), 0);
+    const std::complex<double> minus_half_i(0, -0.5);
+    for (int index = 1; index <= half / 2; index++) {
+        std::complex<double> upper = output[index];
+        std::complex<double> lower = output[half - index];
+        std::complex<double> even = 0.5 * (upper + std::conj(lower));
+        std::complex<double> odd = minus_half_i * (upper - std::conj(lower));
+        output[index] = even + plan.real_twiddles[index] * odd;
+        even = 0.5 * (lower + std::conj(upper));
+        odd = minus_half_i * (lower - std::conj(upper));
+        output[half - index] = even + plan.real_twiddles[half - index] * odd;
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::FFT::zoom(const double *input, int length, double start, double step, int count, std::complex<double> *output) {
+    /*
+        chirp-z transform of real samples: bins on an arbitrary, equally spaced frequency grid,
+        the cost depends on the number of samples and bins, not on the resolution
+
+        parameters: - input - real samples
+                    - length - number of samples
+                    - start - frequency of the first bin, relative to the sample rate (0 to 0.5)
+                    - step - spacing of the bins, relative to the sample rate
+                    - count - number of bins
+                    - output - buffer for count complex bins
+    */
+    if (length < 1 || count < 1) {
+        return;
+    }
+
+    // the sum of x[n] * exp(-2i*pi*(start + k*step)*n) is a convolution with a chirp, because n*k = (n^2 + k^2 - (k - n)^2) / 2;
+    // long buffers are split into blocks a few times longer than the output, the block results are rotated to
+    // their position and added, so the transforms stay small
+    int size = 1;
+    while (size < length + count - 1 && (size < 4 * count || size < 1024)) {
+        size <<= 1;
+    }
+    int block = size - count + 1;
+    const Plan &plan = *get_plan(size);
+
+    // the phases are reduced to one turn before the multiplication by 2*pi, so long buffers keep their precision
+    thread_local std::vector<std::complex<double>> modulation;
+    thread_local std::vector<std::complex<double>> chirp;
+    thread_local std::vector<std::complex<double>> rotation;
+    thread_local std::vector<std::complex<double>> advance;
+    thread_local std::vector<std::complex<double>> work;
+    modulation.resize(block);
+    for (int index = 0; index < block; index++) {
+        double turns = start * index + 0.5 * step * ((double)index * index);
+        modulation[index] = std::polar(1.0, -2 * pi * (turns - std::floor(turns)));
+    }
+    chirp.assign(size, std::complex<double>(0, 0));
+    int last = block > count ? block : count;
+    for (int index = 0; index < last; index++) {
+        double turns = 0.5 * step * ((double)index * index);
+        std::complex<double> value = std::polar(1.0, 2 * pi * (turns - std::floor(turns)));
+        if (index < count) {
+            chirp[index] = value;
+        }
+        if (index > 0 && index < block) {
+            chirp[size - index] = value;
+        }
+    }
+    radix2(chirp.data(), plan, false);
+    rotation.resize(count);
+    advance.resize(count);
+    for (int index = 0; index < count; index++) {
+        // the chirp removed from the result, the scale of the inverse transform, and the step of the block position
+        double turns = 0.5 * step * ((double)index * index);
+        rotation[index] = std::polar(1.0 / size, -2 * pi * (turns - std::floor(turns)));
+        turns = (start + index * step) * block;
+        advance[index] = std::polar(1.0, -2 * pi * (turns - std::floor(turns)));
+        output[index] = 0;
+    }
+
+    // circular convolution of every block with power of two transforms
+    for (int first = 0; first < length; first += block) {
+        int samples = length - first < block ? length - first : block;
+        work.assign(size, std::complex<double>(0, 0));
+        for (int index = 0; index < samples; index++) {
+            work[index] = input[first + index] * modulation[index];
+        }
+        radix2(work.data(), plan, false);
+        for (int index = 0; index < size; index++) {
+            work[index] *= chirp[index];
+        }
+        radix2(work.data(), plan, true);
+        for (int index = 0; index < count; index++) {
+            output[index] += work[index] * rotation[index];
+            rotation[index] *= advance[index];
+        }
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+std::shared_ptr<const std::vector<double>> wf::FFT::window(DwfWindow window, int length) {
+    /*
+        get a window, it is generated once for every type and length
+
+        parameters: - window type: tools.window.rectangular, triangular, hamming, hann, cosine,
+                                   blackman_harris, flat_top, kaiser
+                    - length - number of samples
+
+        returns:    - window coefficients, normalized to an average of 1, so tones keep their amplitude
+    */
+    std::pair<int, int> key(window, length);
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        std::map<std::pair<int, int>, std::shared_ptr<const std::vector<double>>>::iterator found = windows.find(key);
+        if (found != windows.end()) {
+            return found->second;
+        }
+    }
+
+    std::shared_ptr<std::vector<double>> coefficients(new std::vector<double>(length, 1.0));
+    std::vector<double> &values = *coefficients;
+    double last = length > 1 ? length - 1 : 1;
+    for (int index = 0; index < length; index++) {
+        double phase = 2 * pi * index / last;
+        if (window == DwfWindowTriangular) {
+            values[index] = 1 - std::fabs((index - last / 2) / (length / 2.0));
+        }
+        else if (window == DwfWindowHamming) {
+            values[index] = 0.54 - 0.46 * std::cos(phase);
+        }
+        else if (window == DwfWindowHann) {
+            values[index] = 0.5 - 0.5 * std::cos(phase);
+        }
+        else if (window == DwfWindowCosine) {
+            values[index] = std::sin(pi * index / last);
+        }
+        else if (window == DwfWindowBlackman) {
+            values[index] = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2 * phase);
+        }
+        else if (window == DwfWindowBlackmanHarris) {
+            values[index] = 0.35875 - 0.48829 * std::cos(phase) + 0.14128 * std::cos(2 * phase) - 0.01168 * std::cos(3 * phase);
+        }
+        else if (window == DwfWindowFlatTop) {
+            values[index] = 0.21557895 - 0.41663158 * std::cos(phase) + 0.277263158 * std::cos(2 * phase) - 0.083578947 * std::cos(3 * phase) + 0.006947368 * std::cos(4 * phase);
+        }
+        else if (window == DwfWindowKaiser) {
+            // beta is 1, the value which was passed to FDwfSpectrumWindow
+            double beta = 1.0;
+            double position = 2.0 * index / last - 1;
+            double argument = beta * std::sqrt(std::max(0.0, 1 - position * position));
+            // modified Bessel function of the first kind, order 0
+            double numerator = 1, denominator = 1, term = 1, term_beta = 1;
+            for (int order = 1; order < 32; order++) {
+                term *= (argument / (2 * order)) * (argument / (2 * order));
+                term_beta *= (beta / (2 * order)) * (beta / (2 * order));
+                numerator += term;
+                denominator += term_beta;
+            }
+            values[index] = numerator / denominator;
+        }
+    }
+
+    // normalize the coherent gain
+    double sum = 0;
+    for (int index = 0; index < length; index++) {
+        sum += values[index];
+    }
+    if (sum > 0) {
+        for (int index = 0; index < length; index++) {
+            values[index] *= length / sum;
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    windows[key] = coefficients;
+    return coefficients;
+}
+
+/* ----------------------------------------------------- */
+
+std::shared_ptr<const wf::FFT::Plan> wf::FFT::get_plan(int length) {
+    /*
+        get the plan of a transform size, it is computed once
+    */
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        std::map<int, std::shared_ptr<const Plan>>::iterator found = plans.find(length);
+        if (found != plans.end()) {
+            return found->second;
+        }
+    }
+
+    // the plan is built without holding the lock, Bluestein plans need an inner plan
+    std::shared_ptr<Plan> plan(new Plan());
+    plan->length = length;
+    plan->radix2 = (length & (length - 1)) == 0;
+
+    // factors used when this transform is the half length transform of a real one
+    plan->real_twiddles.resize(length + 1);
+    for (int index = 0; index <= length; index++) {
+        plan->real_twiddles[index] = std::polar(1.0, -pi * index / length);
+    }
+
+    if (plan->radix2) {
+        int bits = 0;
+        while ((1 << bits) < length) {
+            bits++;
+        }
+        plan->reversed.resize(length);
+        for (int index = 0; index < length; index++) {
+            int reversed = 0;
+            for (int bit = 0; bit < bits; bit++) {
+                reversed |= ((index >> bit) & 1) << (bits - 1 - bit);
+            }
+            plan->reversed[index] = reversed;
+        }
+        for (int size = 2; size <= length; size <<= 1) {
+            for (int index = 0; index < size / 2; index++) {
+                plan->twiddles.push_back(std::polar(1.0, -2 * pi * index / size));
+            }
+        }
+    }
+    else {
+        // Bluestein: the transform is a convolution with a chirp, done with a power of two transform
+        int size = 1;
+        while (size < 2 * length - 1) {
+            size <<= 1;
+        }
+        plan->inner = get_plan(size);
+        plan->chirp.resize(length);
+        for (int index = 0; index < length; index++) {
+            long long square = ((long long)index * index) % (2LL * length);
+            plan->chirp[index] = std::polar(1.0, -pi * square / length);
+        }
+        plan->chirp_spectrum.assign(size, std::complex<double>(0, 0));
+        plan->chirp_spectrum[0] = std::conj(plan->chirp[0]);
+        for (int index = 1; index < length; index++) {
+            plan->chirp_spectrum[index] = std::conj(plan->chirp[index]);
+            plan->chirp_spectrum[size - index] = std::conj(plan->chirp[index]);
+        }
+        radix2(plan->chirp_spectrum.data(), *plan->inner, false);
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    std::map<int, std::shared_ptr<const Plan>>::iterator found = plans.find(length);
+    if (found != plans.end()) {
+        return found->second;
+    }
+    plans[length] = plan;
+    return plan;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::FFT::execute(std::complex<double> *data, const Plan &plan, bool inverse) {
+    /*
+        unscaled in-place transform with a plan
+    */
+    if (plan.radix2) {
+        radix2(data, plan, inverse);
+    }
+    else {
+        bluestein(data, plan, inverse);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::FFT::radix2(std::complex<double> *data, const Plan &plan, bool inverse) {
+    /*
+        iterative radix-2 decimation in time transform, the twiddles of every stage are contiguous
+    */
+    int length = plan.length;
+    for (int index = 0; index < length; index++) {
+        int reversed = plan.reversed[index];
+        if (index < reversed) {
+            std::swap(data[index], data[reversed]);
+        }
+    }
+
+    const std::complex<double> *twiddles = plan.twiddles.data();
+#if defined(__SSE2__) || defined(_M_X64)
+    // one complex number fits in a register: (real, imaginary)
+    const __m128d conjugate = inverse ? _mm_set_pd(-1.0, 1.0) : _mm_set_pd(1.0, 1.0);
+    const __m128d sign = _mm_set_pd(1.0, -1.0);
+#endif
+    for (int size = 2; size <= length; size <<= 1) {
+        int half = size / 2;
+        for (int start = 0; start < length; start += size) {
+            std::complex<double> *upper = data + start;
+            std::complex<double> *lower = data + start + half;
+#if defined(__SSE2__) || defined(_M_X64)
+            for (int index = 0; index < half; index++) {
+                __m128d factor = _mm_mul_pd(_mm_loadu_pd((const double *)(twiddles + index)), conjugate);
+                __m128d value = _mm_loadu_pd((const double *)(lower + index));
+                __m128d product = _mm_add_pd(_mm_mul_pd(_mm_unpacklo_pd(factor, factor), value),
+                                             _mm_mul_pd(_mm_mul_pd(_mm_unpackhi_pd(factor, factor), _mm_shuffle_pd(value, value, 1)), sign));
+                __m128d sum = _mm_loadu_pd((const double *)(upper + index));
+                _mm_storeu_pd((double *)(upper + index), _mm_add_pd(sum, product));
+                _mm_storeu_pd((double *)(lower + index), _mm_sub_pd(sum, product));
+            }
+#else
+            for (int index = 0; index < half; index++) {
+                std::complex<double> factor = inverse ? std::conj(twiddles[index]) : twiddles[index];
+                std::complex<double> product = lower[index] * factor;
+                lower[index] = upper[index] - product;
+                upper[index] += product;
+            }
+#endif
+        }
+        twiddles += half;
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::FFT::bluestein(std::complex<double> *data, const Plan &plan, bool inverse) {
+    /*
+        transform of any length as a circular convolution with a chirp
+    */
+    const Plan &inner = *plan.inner;
+    thread_local std::vector<std::complex<double>> work;
+    work.assign(inner.length, std::complex<double>(0, 0));
+
+    // the inverse transform is the conjugate of the transform of the conjugate
+    for (int index = 0; index < plan.length; index++) {
+        std::complex<double> value = inverse ? std::conj(data[index]) : data[index];
+        work[index] = value * plan.chirp[index];
+    }
+    radix2(work.data(), inner, false);
+    for (int index = 0; index < inner.length; index++) {
+        work[index] *= plan.chirp_spectrum[index];
+    }
+    radix2(work.data(), inner, true);
+
+    double scale = 1.0 / inner.length;
+    for (int index = 0; index < plan.length; index++) {
+        std::complex<double> value = work[index] * plan.chirp[index] * scale;
+        data[index] = inverse ? std::conj(value) : value;
+    }
+    return;
+}
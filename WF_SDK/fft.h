@@ -0,0 +1,53 @@
+/* FFT ENGINE FUNCTIONS: transform, inverse, real, zoom, window */
+
+/* include the necessary libraries */
+#include <vector>
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <cmath>
+#include <algorithm>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#include "dwf.h"
+
+#ifndef WF_FFT
+#define WF_FFT
+namespace wf {
+
+class FFT {
+    private:
+        class Plan {
+            /* precomputed tables of a transform size */
+            public:
+                int length = 0;
+                bool radix2 = false;
+                std::vector<int> reversed;                      // bit reversed indices (radix-2)
+                std::vector<std::complex<double>> twiddles;     // twiddle factors of every stage, in stage order (radix-2)
+                std::vector<std::complex<double>> real_twiddles;    // factors to split a half length transform into a real one
+                std::vector<std::complex<double>> chirp;        // Bluestein chirp (other lengths)
+                std::vector<std::complex<double>> chirp_spectrum;   // transform of the conjugated chirp (other lengths)
+                std::shared_ptr<const Plan> inner;              // power of two plan of the Bluestein convolution
+        };
+
+        std::map<int, std::shared_ptr<const Plan>> plans;
+        std::map<std::pair<int, int>, std::shared_ptr<const std::vector<double>>> windows;
+        std::mutex lock;
+
+        std::shared_ptr<const Plan> get_plan(int length);
+        void radix2(std::complex<double> *data, const Plan &plan, bool inverse);
+        void bluestein(std::complex<double> *data, const Plan &plan, bool inverse);
+        void execute(std::complex<double> *data, const Plan &plan, bool inverse);
+
+    public:
+        void transform(std::complex<double> *data, int length);
+        void inverse(std::complex<double> *data, int length);
+        void real(const double *input, int length, std::complex<double> *output);
+        void zoom(const double *input, int length, double start, double step, int count, std::complex<double> *output);
+        std::shared_ptr<const std::vector<double>> window(DwfWindow window, int length);
+} fft;
+
+}
+#endif
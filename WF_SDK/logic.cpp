@@ -14,6 +14,9 @@ void wf::Logic::open(Device::Data *device_data, double sampling_frequency, int b
                     - buffer size, default is 0 (maximum)
     */
     
+    // get the digital input information, if it isn't known yet
+    device.get_info(device_data, device.info.digital_input);
+
     //set global variables
     data.sampling_frequency = sampling_frequency;
     data.max_buffer_size = device_data->digital.input.max_buffer_size;
@@ -130,9 +133,11 @@ std::vector<unsigned short> wf::Logic::record(Device::Data *device_data, int cha
                     - channel - the selected DIO line number
 
         returns:    - buffer - a list with the recorded logic values
+                      (data.start_time is the timestamp of the first sample, see tools.timestamp)
     */
     
     // set up the instrument
+    long long start = tools.timestamp();
     if (FDwfDigitalInConfigure(device_data->handle, false, true) == 0) {
         device.check_error(device_data);
     }
@@ -150,6 +155,8 @@ std::vector<unsigned short> wf::Logic::record(Device::Data *device_data, int cha
         }
     }
 
+    data.start_time = tools.acquisition_start(start, data.buffer_size, data.sampling_frequency);
+
     // get samples
     std::vector<unsigned short> buffer(data.buffer_size);
     if (FDwfDigitalInStatusData(device_data->handle, buffer.data(), 2 * data.buffer_size) == 0) {
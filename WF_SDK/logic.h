@@ -17,11 +17,13 @@ class Logic {
                 int sampling_frequency = 100e06;
                 int buffer_size = 0;
                 int max_buffer_size = 0;
+                long long start_time = 0;
                 Data& operator=(const Data &data) {
                         if (this != &data) {
                             sampling_frequency = data.sampling_frequency;
                             buffer_size = data.buffer_size;
                             max_buffer_size = data.max_buffer_size;
+                            start_time = data.start_time;
                         }
                         return *this;
                     }
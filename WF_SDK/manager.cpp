@@ -0,0 +1,217 @@
+/* DEVICE MANAGER FUNCTIONS: open, count, unit, submit, run, close */
+
+/* include the header */
+#include "manager.h"
+
+/* ----------------------------------------------------- */
+
+int wf::Manager::open(std::string device, int config, bool use_cache) {
+    /*
+        open every available device in parallel and start a worker thread for each
+
+        parameters: - device type: "" (all devices), or a device name accepted by device.open
+                    - configuration
+                    - use_cache - load the device information from the disk cache if possible, default is True
+
+        returns:    - the number of opened devices
+    */
+    close();
+
+    // decode device names
+    std::map<std::string, int> device_names = wf::device.names();
+    ENUMFILTER device_type = enumfilterAll;
+    for (std::map<std::string, int>::iterator pair = device_names.begin(); pair != device_names.end(); ++pair) {
+        if (device == pair->first) {
+            device_type = pair->second;
+            break;
+        }
+    }
+
+    // count devices
+    int device_count = 0;
+    FDwfEnum(device_type, &device_count);
+
+    // open the devices in parallel, busy devices are skipped
+    std::vector<Device::Data*> opened(device_count > 0 ? device_count : 0, nullptr);
+    std::vector<std::thread> threads;
+    for (int index = 0; index < device_count; index++) {
+        threads.push_back(std::thread([&opened, index, config, use_cache]() {
+            try {
+                opened[index] = wf::device.open_index(index, config, use_cache);
+            }
+            catch (Error error) {
+                opened[index] = nullptr;
+            }
+        }));
+    }
+    for (size_t index = 0; index < threads.size(); index++) {
+        threads[index].join();
+    }
+
+    // start a worker for every opened device
+    for (int index = 0; index < device_count; index++) {
+        if (opened[index] == nullptr) {
+            continue;
+        }
+        if (opened[index]->handle == hdwfNone) {
+            wf::device.close(opened[index]);
+            continue;
+        }
+        Worker *worker = new Worker();
+        worker->unit.index = index;
+        worker->unit.device_data = opened[index];
+        worker->unit.network.generator = &worker->unit.wavegen;
+        worker->running = true;
+        worker->thread = std::thread(&Manager::work, this, worker);
+        workers.push_back(worker);
+    }
+
+    // check for opened devices
+    if (workers.empty()) {
+        Error error;
+        error.instrument = "manager";
+        error.function = "open";
+        if (device_type == enumfilterAll) {
+            error.message = "There are no available devices";
+        }
+        else {
+            error.message = "There is no available " + device;
+        }
+        throw error;
+    }
+    return int(workers.size());
+}
+
+/* ----------------------------------------------------- */
+
+int wf::Manager::count(void) {
+    /*
+        return the number of opened devices
+    */
+    return int(workers.size());
+}
+
+/* ----------------------------------------------------- */
+
+wf::Manager::Unit& wf::Manager::unit(int index) {
+    /*
+        get an opened device and its instruments
+
+        parameters: - device number between 0 and count() - 1
+
+        returns:    - the device data and instruments of the device
+    */
+    if (index < 0 || index >= int(workers.size())) {
+        Error error;
+        error.instrument = "manager";
+        error.function = "unit";
+        error.message = "There is no device with number " + std::to_string(index);
+        throw error;
+    }
+    return workers[index]->unit;
+}
+
+/* ----------------------------------------------------- */
+
+std::future<void> wf::Manager::submit(int index, std::function<void(Unit&)> task) {
+    /*
+        queue a task on the worker thread of a device
+
+        parameters: - device number between 0 and count() - 1
+                    - task, called with the device data and instruments of the device
+
+        returns:    - future of the task, get() rethrows the errors of the task
+    */
+    Unit &target = unit(index);
+    Worker *worker = workers[index];
+    std::shared_ptr<std::packaged_task<void(void)>> job(new std::packaged_task<void(void)>([task, &target]() {
+        task(target);
+    }));
+    std::future<void> result = job->get_future();
+    {
+        std::lock_guard<std::mutex> guard(worker->lock);
+        worker->queue.push_back([job]() {
+            (*job)();
+        });
+    }
+    worker->wake.notify_one();
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Manager::run(std::function<void(Unit&)> task) {
+    /*
+        run a task on every device in parallel and wait for all of them
+
+        parameters: - task, called with the device data and instruments of each device
+
+        the first exception of any type is rethrown after every task finished
+    */
+    std::vector<std::future<void>> results;
+    for (int index = 0; index < int(workers.size()); index++) {
+        results.push_back(submit(index, task));
+    }
+    std::exception_ptr error = nullptr;
+    for (size_t index = 0; index < results.size(); index++) {
+        try {
+            results[index].get();
+        }
+        catch (...) {
+            if (error == nullptr) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Manager::close(void) {
+    /*
+        finish the queued tasks, stop the worker threads and close every device
+    */
+    for (size_t index = 0; index < workers.size(); index++) {
+        {
+            std::lock_guard<std::mutex> guard(workers[index]->lock);
+            workers[index]->running = false;
+        }
+        workers[index]->wake.notify_one();
+    }
+    for (size_t index = 0; index < workers.size(); index++) {
+        if (workers[index]->thread.joinable()) {
+            workers[index]->thread.join();
+        }
+        wf::device.close(workers[index]->unit.device_data);
+        delete workers[index];
+    }
+    workers.clear();
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Manager::work(Worker *worker) {
+    /*
+        execute the queued tasks of a device in order
+    */
+    while (true) {
+        std::function<void(void)> task;
+        {
+            std::unique_lock<std::mutex> guard(worker->lock);
+            worker->wake.wait(guard, [worker]() {
+                return !worker->running || !worker->queue.empty();
+            });
+            if (worker->queue.empty()) {
+                return;
+            }
+            task = worker->queue.front();
+            worker->queue.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,80 @@
+/* DEVICE MANAGER FUNCTIONS: open, count, unit, submit, run, close */
+
+/* include the necessary libraries */
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <future>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "dwf.h"
+#include "device.h"
+#include "scope.h"
+#include "wavegen.h"
+#include "network.h"
+#include "supplies.h"
+#include "dmm.h"
+#include "logic.h"
+#include "pattern.h"
+#include "static.h"
+#include "protocol/uart.h"
+#include "protocol/spi.h"
+#include "protocol/i2c.h"
+
+#ifndef WF_MANAGER
+#define WF_MANAGER
+namespace wf {
+
+class Manager {
+    public:
+        class Unit {
+            /* an opened device with its own instruments */
+            public:
+                int index = -1;
+                Device::Data *device_data = nullptr;
+                Scope scope;
+                Wavegen wavegen;
+                Network network;
+                Supplies supplies;
+                DMM dmm;
+                Logic logic;
+                Pattern pattern;
+                Static static_;
+                UART uart;
+                SPI spi;
+                I2C i2c;
+        };
+
+    private:
+        class Worker {
+            /* the command queue and thread of a device */
+            public:
+                Unit unit;
+                std::thread thread;
+                std::mutex lock;
+                std::condition_variable wake;
+                std::deque<std::function<void(void)>> queue;
+                bool running = false;
+        };
+
+        std::vector<Worker*> workers;
+        void work(Worker *worker);
+
+    public:
+        int open(std::string device = "", int config = 0, bool use_cache = true);
+        int count(void);
+        Unit& unit(int index);
+        std::future<void> submit(int index, std::function<void(Unit&)> task);
+        void run(std::function<void(Unit&)> task);
+        void close(void);
+        ~Manager() {
+            close();
+        }
+} manager;
+
+}
+#endif
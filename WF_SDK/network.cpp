@@ -0,0 +1,249 @@
+/* NETWORK ANALYZER CONTROL FUNCTIONS: open, sweep, close */
+
+/* include the header */
+#include "network.h"
+#include <cmath>
+#include <chrono>
+#include <thread>
+
+/* ----------------------------------------------------- */
+
+void wf::Network::open(Device::Data *device_data, int wavegen_channel, int reference_channel, int response_channel, double amplitude, double offset, double amplitude_range, int periods, int settle_periods, double settle_time) {
+    /*
+        initialize the network analyzer (wavegen and oscilloscope)
+
+        parameters: - device data
+                    - the wavegen channel used as stimulus (1-2), default is 1
+                    - the oscilloscope channel measuring the DUT input, default is 1
+                    - the oscilloscope channel measuring the DUT output, default is 2
+                    - stimulus amplitude in Volts, default is 1V
+                    - stimulus offset in Volts, default is 0V
+                    - oscilloscope amplitude range in Volts, default is ±5V
+                    - number of signal periods captured at every step, default is 8
+                    - number of signal periods to wait for the DUT to settle, default is 4
+                    - minimum settling time in seconds, default is 1ms
+    */
+    // get the analog input and output information, if it isn't known yet
+    device.get_info(device_data, device.info.analog_input | device.info.analog_output);
+
+    // set global variables
+    settings.wavegen_channel = wavegen_channel;
+    settings.reference_channel = reference_channel;
+    settings.response_channel = response_channel;
+    settings.amplitude = amplitude;
+    settings.offset = offset;
+    settings.periods = periods;
+    settings.settle_periods = settle_periods;
+    settings.settle_time = settle_time;
+    settings.max_buffer_size = device_data->analog.input.max_buffer_size;
+
+    // get the sampling frequency limit
+    double min_frequency = 0;
+    if (FDwfAnalogInFrequencyInfo(device_data->handle, &min_frequency, &settings.max_sampling_frequency) == 0) {
+        device.check_error(device_data);
+    }
+
+    // enable all channels
+    if (FDwfAnalogInChannelEnableSet(device_data->handle, -1, true) == 0) {
+        device.check_error(device_data);
+    }
+
+    // set offset voltage (in Volts)
+    if (FDwfAnalogInChannelOffsetSet(device_data->handle, -1, 0) == 0) {
+        device.check_error(device_data);
+    }
+
+    // set range (maximum signal amplitude in Volts)
+    if (FDwfAnalogInChannelRangeSet(device_data->handle, -1, amplitude_range) == 0) {
+        device.check_error(device_data);
+    }
+
+    // average samples when the sampling frequency is lowered
+    if (FDwfAnalogInChannelFilterSet(device_data->handle, -1, filterAverage) == 0) {
+        device.check_error(device_data);
+    }
+
+    // both channels are captured together, so no trigger is needed for the phase
+    if (FDwfAnalogInTriggerSourceSet(device_data->handle, trigsrcNone) == 0) {
+        device.check_error(device_data);
+    }
+
+    // set up the stimulus
+    int channel = wavegen_channel - 1;
+    if (FDwfAnalogOutNodeEnableSet(device_data->handle, channel, AnalogOutNodeCarrier, true) == 0) {
+        device.check_error(device_data);
+    }
+    if (FDwfAnalogOutNodeFunctionSet(device_data->handle, channel, AnalogOutNodeCarrier, funcSine) == 0) {
+        device.check_error(device_data);
+    }
+    if (FDwfAnalogOutNodeAmplitudeSet(device_data->handle, channel, AnalogOutNodeCarrier, amplitude) == 0) {
+        device.check_error(device_data);
+    }
+    if (FDwfAnalogOutNodeOffsetSet(device_data->handle, channel, AnalogOutNodeCarrier, offset) == 0) {
+        device.check_error(device_data);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Network::Data wf::Network::sweep(Device::Data *device_data, double start_frequency, double stop_frequency, int steps, bool logarithmic) {
+    /*
+        measure the frequency response of a DUT
+
+        parameters: - device data
+                    - start frequency in Hz
+                    - stop frequency in Hz
+                    - number of frequency points, default is 100
+                    - logarithmic frequency steps, default is True
+
+        returns:    - class containing the frequency (Hz), gain (dB), phase (degrees)
+                      and the amplitudes of the two channels (V) at every step
+    */
+    Data result;
+    if (steps < 1) {
+        return result;
+    }
+    result.frequency.resize(steps);
+    result.gain.resize(steps);
+    result.phase.resize(steps);
+    result.reference_amplitude.resize(steps);
+    result.response_amplitude.resize(steps);
+
+    // the capture buffers are allocated once for the whole sweep
+    std::vector<double> reference(settings.max_buffer_size);
+    std::vector<double> response(settings.max_buffer_size);
+
+    int channel = settings.wavegen_channel - 1;
+    for (int step = 0; step < steps; step++) {
+        // calculate the current frequency
+        double frequency = start_frequency;
+        if (steps > 1) {
+            if (logarithmic) {
+                frequency = start_frequency * pow(stop_frequency / start_frequency, double(step) / (steps - 1));
+            }
+            else {
+                frequency = start_frequency + (stop_frequency - start_frequency) * step / (steps - 1);
+            }
+        }
+
+        // change the stimulus frequency, the first step starts the generator, the others only apply the change
+        if (step == 0) {
+            if (FDwfAnalogOutNodeFrequencySet(device_data->handle, channel, AnalogOutNodeCarrier, frequency) == 0) {
+                device.check_error(device_data);
+            }
+            if (FDwfAnalogOutConfigure(device_data->handle, channel, true) == 0) {
+                device.check_error(device_data);
+            }
+        }
+        else {
+            (generator != nullptr ? generator : &wavegen)->set_frequency(device_data, settings.wavegen_channel, frequency);
+        }
+
+        // adapt the sampling frequency to the signal
+        double sampling_frequency = frequency * settings.samples_per_period;
+        if (settings.max_sampling_frequency > 0 && sampling_frequency > settings.max_sampling_frequency) {
+            sampling_frequency = settings.max_sampling_frequency;
+        }
+        if (FDwfAnalogInFrequencySet(device_data->handle, sampling_frequency) == 0) {
+            device.check_error(device_data);
+        }
+        if (FDwfAnalogInFrequencyGet(device_data->handle, &sampling_frequency) == 0) {
+            device.check_error(device_data);
+        }
+
+        // capture a whole number of periods that fits in the buffer
+        int periods = settings.periods;
+        int max_periods = int(settings.max_buffer_size * frequency / sampling_frequency);
+        if (periods > max_periods) {
+            periods = max_periods > 0 ? max_periods : 1;
+        }
+        int buffer_size = int(round(periods * sampling_frequency / frequency));
+        if (buffer_size > settings.max_buffer_size) {
+            buffer_size = settings.max_buffer_size;
+        }
+        if (FDwfAnalogInBufferSizeSet(device_data->handle, buffer_size) == 0) {
+            device.check_error(device_data);
+        }
+
+        // wait for the DUT to settle
+        double settle_time = settings.settle_periods / frequency;
+        if (settle_time < settings.settle_time) {
+            settle_time = settings.settle_time;
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double>(settle_time));
+
+        // record both channels
+        if (FDwfAnalogInConfigure(device_data->handle, true, true) == 0) {
+            device.check_error(device_data);
+        }
+        while (true) {
+            unsigned char status = 0;
+            if (FDwfAnalogInStatus(device_data->handle, true, &status) == 0) {
+                device.check_error(device_data);
+            }
+            if (status == DwfStateDone) {
+                break;
+            }
+        }
+        if (FDwfAnalogInStatusData(device_data->handle, settings.reference_channel - 1, reference.data(), buffer_size) == 0) {
+            device.check_error(device_data);
+        }
+        if (FDwfAnalogInStatusData(device_data->handle, settings.response_channel - 1, response.data(), buffer_size) == 0) {
+            device.check_error(device_data);
+        }
+
+        // evaluate the stimulus frequency bin only
+        std::complex<double> reference_bin = goertzel(reference.data(), buffer_size, frequency / sampling_frequency);
+        std::complex<double> response_bin = goertzel(response.data(), buffer_size, frequency / sampling_frequency);
+        std::complex<double> transfer = response_bin / reference_bin;
+
+        result.frequency[step] = frequency;
+        result.reference_amplitude[step] = 2.0 * std::abs(reference_bin) / buffer_size;
+        result.response_amplitude[step] = 2.0 * std::abs(response_bin) / buffer_size;
+        result.gain[step] = 20.0 * log10(std::abs(transfer));
+        result.phase[step] = std::arg(transfer) * 180.0 / pi;
+    }
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Network::close(Device::Data *device_data) {
+    /*
+        reset the oscilloscope and the wavegen
+    */
+    if (FDwfAnalogInReset(device_data->handle) == 0) {
+        device.check_error(device_data);
+    }
+    if (FDwfAnalogOutReset(device_data->handle, settings.wavegen_channel - 1) == 0) {
+        device.check_error(device_data);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+std::complex<double> wf::Network::goertzel(const double *buffer, int length, double frequency) {
+    /*
+        calculate a single DFT bin with the Goertzel algorithm
+
+        parameters: - pointer to the samples
+                    - number of samples
+                    - bin frequency relative to the sampling frequency (cycles/sample)
+
+        returns:    - the complex DFT value at the given frequency
+    */
+    double omega = 2.0 * pi * frequency;
+    double coefficient = 2.0 * cos(omega);
+    double state1 = 0;
+    double state2 = 0;
+    for (int index = 0; index < length; index++) {
+        double state = buffer[index] + coefficient * state1 - state2;
+        state2 = state1;
+        state1 = state;
+    }
+    // remove the phase rotation accumulated by the recursion
+    std::complex<double> value = state1 - state2 * std::polar(1.0, -omega);
+    return value * std::polar(1.0, -omega * (length - 1));
+}
@@ -0,0 +1,78 @@
+/* NETWORK ANALYZER CONTROL FUNCTIONS: open, sweep, close */
+
+/* include the necessary libraries */
+#include <vector>
+#include <complex>
+#include "dwf.h"
+#include "device.h"
+#include "wavegen.h"
+#include "tools.h"
+
+#ifndef WF_NETWORK
+#define WF_NETWORK
+namespace wf {
+
+class Network {
+    private:
+        class Settings {
+            public:
+                int wavegen_channel = 1;
+                int reference_channel = 1;
+                int response_channel = 2;
+                double amplitude = 1;
+                double offset = 0;
+                int periods = 8;
+                int samples_per_period = 64;
+                int settle_periods = 4;
+                double settle_time = 1e-03;
+                double max_sampling_frequency = 0;
+                int max_buffer_size = 0;
+                Settings& operator=(const Settings &data) {
+                    if (this != &data) {
+                        wavegen_channel = data.wavegen_channel;
+                        reference_channel = data.reference_channel;
+                        response_channel = data.response_channel;
+                        amplitude = data.amplitude;
+                        offset = data.offset;
+                        periods = data.periods;
+                        samples_per_period = data.samples_per_period;
+                        settle_periods = data.settle_periods;
+                        settle_time = data.settle_time;
+                        max_sampling_frequency = data.max_sampling_frequency;
+                        max_buffer_size = data.max_buffer_size;
+                    }
+                    return *this;
+                }
+        };
+
+        std::complex<double> goertzel(const double *buffer, int length, double frequency);
+
+    public:
+        class Data {
+            public:
+                std::vector<double> frequency;
+                std::vector<double> gain;
+                std::vector<double> phase;
+                std::vector<double> reference_amplitude;
+                std::vector<double> response_amplitude;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        frequency = data.frequency;
+                        gain = data.gain;
+                        phase = data.phase;
+                        reference_amplitude = data.reference_amplitude;
+                        response_amplitude = data.response_amplitude;
+                    }
+                    return *this;
+                }
+        };
+
+        Settings settings;
+        Wavegen *generator = nullptr;   // wavegen instance used to retune the stimulus, nullptr means the global wavegen
+        void open(Device::Data *device_data, int wavegen_channel = 1, int reference_channel = 1, int response_channel = 2, double amplitude = 1, double offset = 0, double amplitude_range = 5, int periods = 8, int settle_periods = 4, double settle_time = 1e-03);
+        Data sweep(Device::Data *device_data, double start_frequency, double stop_frequency, int steps = 100, bool logarithmic = true);
+        void close(Device::Data *device_data);
+} network;
+
+}
+#endif
@@ -1,4 +1,4 @@
-/* PATTERN GENERATOR CONTROL FUNCTIONS: generate, close */
+/* PATTERN GENERATOR CONTROL FUNCTIONS: generate, compile, generate_bus, close, enable, disable */
 
 /* include the header */
 #include "pattern.h"
@@ -133,16 +133,15 @@ void wf::Pattern::generate(Device::Data *device_data, int channel, DwfDigitalOut
     else if (function == DwfDigitalOutTypeCustom) {
         // format data
         int buffer_length = (data.size() + 7) >> 3;
-        std::vector<unsigned short> buffer(buffer_length);
+        std::vector<unsigned char> buffer(buffer_length, 0);
         for (int index = 0; index < data.size(); index++) {
-            buffer[index] = 0;
             if (data[index] != 0) {
                 buffer[index >> 3] |= 1 << (index & 7);
             }
         }
     
-        // load data
-        if (FDwfDigitalOutDataSet(device_data->handle, channel, buffer.data(), buffer.size()) == 0) {
+        // load data (the length is given in bits)
+        if (FDwfDigitalOutDataSet(device_data->handle, channel, buffer.data(), data.size()) == 0) {
             device.check_error(device_data);
         }
     }
@@ -156,6 +155,136 @@ void wf::Pattern::generate(Device::Data *device_data, int channel, DwfDigitalOut
 
 /* ----------------------------------------------------- */
 
+wf::Pattern::Bus wf::Pattern::compile(const std::vector<unsigned short> &data, int width) {
+    /*
+        convert a list of parallel bus words into bit-packed buffers, one for every line
+
+        parameters: - data - list of bus words, bit n of a word is the value of line n
+                    - width - the number of bus lines (1-16), default is 16
+
+        returns:    - class containing the bus width, the sample count and the buffers
+    */
+    Bus bus;
+    width = width < 1 ? 1 : (width > 16 ? 16 : width);
+    bus.width = width;
+    bus.length = data.size();
+    int buffer_length = (bus.length + 7) >> 3;
+    bus.bits.assign(width, std::vector<unsigned char>(buffer_length, 0));
+
+    int index = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    // transpose 16 words at a time: the bytes are shifted so that the required bit
+    // becomes the sign bit, then movemask collects the 16 bits of one line
+    const __m128i low_mask = _mm_set1_epi16(0x00FF);
+    for ( ; index + 16 <= bus.length; index += 16) {
+        __m128i first = _mm_loadu_si128((const __m128i *)(data.data() + index));
+        __m128i second = _mm_loadu_si128((const __m128i *)(data.data() + index + 8));
+        __m128i bytes[2];
+        bytes[0] = _mm_packus_epi16(_mm_and_si128(first, low_mask), _mm_and_si128(second, low_mask));
+        bytes[1] = _mm_packus_epi16(_mm_srli_epi16(first, 8), _mm_srli_epi16(second, 8));
+        for (int line = 0; line < width; line++) {
+            __m128i shifted = bytes[line >> 3];
+            switch (line & 7) {
+                case 0: shifted = _mm_slli_epi64(shifted, 7); break;
+                case 1: shifted = _mm_slli_epi64(shifted, 6); break;
+                case 2: shifted = _mm_slli_epi64(shifted, 5); break;
+                case 3: shifted = _mm_slli_epi64(shifted, 4); break;
+                case 4: shifted = _mm_slli_epi64(shifted, 3); break;
+                case 5: shifted = _mm_slli_epi64(shifted, 2); break;
+                case 6: shifted = _mm_slli_epi64(shifted, 1); break;
+                default: break;
+            }
+            int mask = _mm_movemask_epi8(shifted);
+            bus.bits[line][index >> 3] = (unsigned char)(mask & 0xFF);
+            bus.bits[line][(index >> 3) + 1] = (unsigned char)(mask >> 8);
+        }
+    }
+#endif
+    // process the remaining words one by one
+    for ( ; index < bus.length; index++) {
+        unsigned short word = data[index];
+        for (int line = 0; line < width; line++) {
+            if ((word >> line) & 1) {
+                bus.bits[line][index >> 3] |= 1 << (index & 7);
+            }
+        }
+    }
+    return bus;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Pattern::generate_bus(Device::Data *device_data, int channel, const Bus &bus, double frequency, double wait, int repeat, double run_time, DwfDigitalOutIdle idle) {
+    /*
+        generate a pattern on a parallel bus, all lines start together
+
+        parameters: - device data
+                    - channel - the DIO line number of the least significant bus bit
+                    - bus - compiled bus data, see compile
+                    - frequency - word rate in Hz
+                    - wait time in seconds, default is 0 seconds
+                    - repeat count, default is infinite (0)
+                    - run time in seconds, 0=infinite, -1=auto
+                    - idle state
+    */
+    if (device_data->name == std::string("Digital Discovery")) {
+        channel = channel - 24;
+    }
+
+    // get internal clock frequency
+    double internal_frequency = 0;
+    if (FDwfDigitalOutInternalClockInfo(device_data->handle, &internal_frequency) == 0) {
+        device.check_error(device_data);
+    }
+    int divider = int(internal_frequency / frequency);
+
+    // set up every line of the bus
+    for (int line = 0; line < bus.width; line++) {
+        int current = channel + line;
+        if (FDwfDigitalOutEnableSet(device_data->handle, current, 1) == 0) {
+            device.check_error(device_data);
+        }
+        if (FDwfDigitalOutTypeSet(device_data->handle, current, DwfDigitalOutTypeCustom) == 0) {
+            device.check_error(device_data);
+        }
+        if (FDwfDigitalOutDividerSet(device_data->handle, current, divider) == 0) {
+            device.check_error(device_data);
+        }
+        if (FDwfDigitalOutIdleSet(device_data->handle, current, idle) == 0) {
+            device.check_error(device_data);
+        }
+        if (FDwfDigitalOutDataSet(device_data->handle, current, (void *)bus.bits[line].data(), bus.length) == 0) {
+            device.check_error(device_data);
+        }
+    }
+
+    // calculate run length
+    if (run_time < 0) {
+        run_time = bus.length / frequency;
+    }
+    if (FDwfDigitalOutRunSet(device_data->handle, run_time) == 0) {
+        device.check_error(device_data);
+    }
+
+    // set wait time
+    if (FDwfDigitalOutWaitSet(device_data->handle, wait) == 0) {
+        device.check_error(device_data);
+    }
+
+    // set repeat count
+    if (FDwfDigitalOutRepeatSet(device_data->handle, repeat) == 0) {
+        device.check_error(device_data);
+    }
+
+    // start all lines at once
+    if (FDwfDigitalOutConfigure(device_data->handle, true) == 0) {
+        device.check_error(device_data);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
 void wf::Pattern::close(Device::Data *device_data) {
     /*
         reset the instrument
@@ -1,8 +1,11 @@
-/* PATTERN GENERATOR CONTROL FUNCTIONS: generate, close, enable, disable */
+/* PATTERN GENERATOR CONTROL FUNCTIONS: generate, compile, generate_bus, close, enable, disable */
 
 /* include the necessary libraries */
 #include <math.h>
 #include <vector>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
 #include "dwf.h"
 #include "device.h"
 
@@ -39,10 +42,28 @@ class Pattern {
         };
 
     public:
+        class Bus {
+            /* bit-packed data of a parallel bus, one buffer for every line */
+            public:
+                int width = 0;
+                int length = 0;
+                std::vector<std::vector<unsigned char>> bits;
+                Bus& operator=(const Bus &data) {
+                    if (this != &data) {
+                        width = data.width;
+                        length = data.length;
+                        bits = data.bits;
+                    }
+                    return *this;
+                }
+        };
+
         Function function;
         Trigger_Source trigger_source;
         Idle_State idle_state;
         void generate(Device::Data *device_data, int channel, DwfDigitalOutType function, double frequency, double duty_cycle = 50.0, std::vector<unsigned short> data = std::vector<unsigned short>(), double wait = 0, int repeat = 0, int run_time = 0, DwfDigitalOutIdle idle = DwfDigitalOutIdleInit, bool trigger_enabled = false, TRIGSRC trigger_source = trigsrcNone, bool trigger_edge_rising = true);
+        Bus compile(const std::vector<unsigned short> &data, int width = 16);
+        void generate_bus(Device::Data *device_data, int channel, const Bus &bus, double frequency, double wait = 0, int repeat = 0, double run_time = 0, DwfDigitalOutIdle idle = DwfDigitalOutIdleInit);
         void close(Device::Data *device_data);
         void enable(Device::Data *device_data, int channel);
         void disable(Device::Data *device_data, int channel);
@@ -0,0 +1,421 @@
+/* PATTERN GENERATOR STREAMING FUNCTIONS: open, write, play_file, status, close */
+
+/* include the header */
+#include "pattern_stream.h"
+#include <chrono>
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* ----------------------------------------------------- */
+
+void wf::Pattern_Stream::open(Device::Data *device_data, int channel, int width, double frequency, int buffer_size, int ring_size) {
+    /*
+        start streaming a pattern fed with write
+
+        parameters: - device data
+                    - channel - the DIO line number of the least significant bit
+                    - width - number of lines (1-16)
+                    - frequency - sample rate in Hz
+                    - buffer_size - play buffer size in samples, default is 0 (a quarter of second)
+                    - ring_size - number of words the producer can queue, default is 1M
+
+        the play buffer starts empty, samples played before the first write are counted as underrun,
+        the play position is estimated from the host clock, so on long streams the refill point drifts
+        against the device clock (about the crystal tolerance), keep the buffer well above the drift
+    */
+    stop();
+    unmap_file();
+    ring.resize(ring_size);
+    start(device_data, channel, width, frequency, buffer_size);
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+int wf::Pattern_Stream::write(Device::Data *device_data, const std::vector<unsigned short> &words) {
+    /*
+        queue pattern words for playback
+
+        parameters: - device data
+                    - words - list of samples, bit n of a word is the value of line n
+
+        returns:    - the number of queued words, less than the list size if the queue is full
+    */
+    if (failed) {
+        device_data->error = error;
+        throw device_data->error;
+    }
+    return int(ring.push(words.data(), words.size()));
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Pattern_Stream::play_file(Device::Data *device_data, std::string path, int channel, int width, double frequency, bool repeat, int buffer_size) {
+    /*
+        stream a pattern file, the file is memory-mapped, not loaded
+
+        parameters: - device data
+                    - path - file of raw samples, one byte per sample if width <= 8, else two bytes (little-endian)
+                    - channel - the DIO line number of the least significant bit
+                    - width - number of lines (1-16)
+                    - frequency - sample rate in Hz
+                    - repeat - restart from the beginning at the end of the file, default is False
+                    - buffer_size - play buffer size in samples, default is 0 (a quarter of second)
+
+        without repeat the lines go to the idle (low) level after the last sample and the output is stopped,
+        the play position is estimated from the host clock, so on long streams the refill point drifts
+        against the device clock (about the crystal tolerance), keep the buffer well above the drift
+    */
+    stop();
+    ring.resize(0);
+    map_file(device_data, path);
+    file_position = 0;
+    file_repeat = repeat;
+    start(device_data, channel, width, frequency, buffer_size);
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Pattern_Stream::Data wf::Pattern_Stream::status(void) {
+    /*
+        returns:    - the stream statistics: samples written, underrun count, lost samples, finished flag
+    */
+    data.samples_written = samples_written;
+    data.underrun_count = underrun_count;
+    data.underrun_samples = underrun_samples;
+    data.finished = finished;
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Pattern_Stream::close(Device::Data *device_data) {
+    /*
+        stop streaming and reset the pattern generator
+    */
+    stop();
+    status();
+    unmap_file();
+    if (FDwfDigitalOutReset(device_data->handle) == 0) {
+        device.check_error(device_data);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Pattern_Stream::stop(void) {
+    /*
+        stop the feeder thread, the sources can be changed only after it
+    */
+    running = false;
+    if (feeder.joinable()) {
+        feeder.join();
+    }
+    if (owner != nullptr) {
+        owner->engines.erase(this);
+        owner = nullptr;
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Pattern_Stream::start(Device::Data *device_data, int channel, int width, double frequency, int buffer_size) {
+    /*
+        set up the play mode, prefill the buffer and start the feeder thread
+    */
+    if (device_data->name == std::string("Digital Discovery")) {
+        channel = channel - 24;
+    }
+    width = width < 1 ? 1 : (width > 16 ? 16 : width);
+    if (buffer_size <= 0) {
+        buffer_size = int(frequency / 4);
+        if (buffer_size < 4096) {
+            buffer_size = 4096;
+        }
+    }
+    data.channel = channel;
+    data.width = width;
+    data.frequency = frequency;
+    data.buffer_size = buffer_size;
+    handle = device_data->handle;
+    bytes_per_sample = width <= 8 ? 1 : 2;
+    samples_written = 0;
+    underrun_count = 0;
+    underrun_samples = 0;
+    finished = false;
+    failed = false;
+
+    // prefill the whole play buffer
+    play_buffer.assign((size_t)buffer_size * bytes_per_sample, 0);
+    samples_written = fill(0, buffer_size);
+
+    // set every line to play mode
+    for (int line = 0; line < width; line++) {
+        if (FDwfDigitalOutEnableSet(device_data->handle, channel + line, 1) == 0) {
+            device.check_error(device_data);
+        }
+        if (FDwfDigitalOutTypeSet(device_data->handle, channel + line, DwfDigitalOutTypePlay) == 0) {
+            device.check_error(device_data);
+        }
+        if (FDwfDigitalOutIdleSet(device_data->handle, channel + line, DwfDigitalOutIdleInit) == 0) {
+            device.check_error(device_data);
+        }
+    }
+
+    // set sample rate and the circular play buffer
+    if (FDwfDigitalOutPlayRateSet(device_data->handle, frequency) == 0) {
+        device.check_error(device_data);
+    }
+    if (FDwfDigitalOutPlayDataSet(device_data->handle, play_buffer.data(), bytes_per_sample * 8, buffer_size) == 0) {
+        device.check_error(device_data);
+    }
+
+    // run continuously
+    if (FDwfDigitalOutRunSet(device_data->handle, 0) == 0) {
+        device.check_error(device_data);
+    }
+    if (FDwfDigitalOutRepeatSet(device_data->handle, 0) == 0) {
+        device.check_error(device_data);
+    }
+
+    // start
+    if (FDwfDigitalOutConfigure(device_data->handle, true) == 0) {
+        device.check_error(device_data);
+    }
+    running = true;
+    feeder = std::thread(&Pattern_Stream::feed, this);
+
+    // device.close stops the feeder before the handle is closed
+    owner = device_data;
+    owner->engines[this] = [this]() {
+        stop();
+    };
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+unsigned long long wf::Pattern_Stream::fill(unsigned long long index, unsigned long long count) {
+    /*
+        copy samples from the source to the play buffer
+
+        parameters: - first sample in the play buffer
+                    - maximum number of samples
+
+        returns:    - number of copied samples
+    */
+    unsigned char *target = play_buffer.data() + index * bytes_per_sample;
+    unsigned long long copied = 0;
+
+    // memory-mapped file source
+    if (file_data != nullptr) {
+        unsigned long long file_samples = file_size / bytes_per_sample;
+        while (copied < count && file_samples > 0) {
+            if (file_position >= file_samples) {
+                if (!file_repeat) {
+                    break;
+                }
+                file_position = 0;
+            }
+            unsigned long long chunk = file_samples - file_position;
+            if (chunk > count - copied) {
+                chunk = count - copied;
+            }
+            memcpy(target + copied * bytes_per_sample, file_data + file_position * bytes_per_sample, chunk * bytes_per_sample);
+            file_position += chunk;
+            copied += chunk;
+        }
+        return copied;
+    }
+
+    // producer ring source, taken in small chunks
+    unsigned short words[256];
+    while (copied < count) {
+        size_t chunk = count - copied < 256 ? size_t(count - copied) : 256;
+        size_t taken = ring.pop(words, chunk);
+        for (size_t index = 0; index < taken; index++) {
+            target[(copied + index) * bytes_per_sample] = (unsigned char)(words[index] & 0xFF);
+            if (bytes_per_sample == 2) {
+                target[(copied + index) * bytes_per_sample + 1] = (unsigned char)(words[index] >> 8);
+            }
+        }
+        copied += taken;
+        if (taken < chunk) {
+            break;
+        }
+    }
+    return copied;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Pattern_Stream::feed(void) {
+    /*
+        feeder thread: refill the part of the play buffer that was already played,
+        after the end of a file the buffer is padded with the idle level and the output is stopped
+    */
+    unsigned long long buffer_size = data.buffer_size;
+    unsigned long long written = samples_written;
+    unsigned long long end = 0;     // end of the file data in the stream, valid if source_finished
+    bool source_finished = false;
+
+    // wake up about four times per buffer length
+    double period = buffer_size / data.frequency / 4;
+    period = period < 0.5e-03 ? 0.5e-03 : (period > 50e-03 ? 50e-03 : period);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    while (running) {
+        // estimate the play position
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        unsigned long long position = (unsigned long long)(elapsed * data.frequency);
+
+        // the last sample of the file was played
+        if (source_finished && position >= end) {
+            if (FDwfDigitalOutConfigure(handle, false) == 0) {
+                char message[512];
+                FDwfGetLastErrorMsg(message);
+                error.instrument = "pattern_stream";
+                error.function = "feed";
+                error.message = message;
+                failed = true;
+            }
+            finished = true;
+            break;
+        }
+
+        if (written < position) {
+            // the device replayed old samples
+            underrun_count++;
+            underrun_samples += position - written;
+            written = position;
+        }
+
+        // refill the free part, split at the end of the buffer
+        unsigned long long space = position + buffer_size - written;
+        while (space > 0) {
+            unsigned long long index = written % buffer_size;
+            unsigned long long chunk = buffer_size - index < space ? buffer_size - index : space;
+            unsigned long long copied = 0;
+            if (source_finished) {
+                // idle level after the end of the file
+                memset(play_buffer.data() + index * bytes_per_sample, 0, chunk * bytes_per_sample);
+                copied = chunk;
+            }
+            else {
+                copied = fill(index, chunk);
+            }
+            if (copied > 0) {
+                if (FDwfDigitalOutPlayUpdateSet(handle, play_buffer.data() + index * bytes_per_sample, (unsigned int)index, (unsigned int)copied) == 0) {
+                    char message[512];
+                    FDwfGetLastErrorMsg(message);
+                    error.instrument = "pattern_stream";
+                    error.function = "feed";
+                    error.message = message;
+                    failed = true;
+                    running = false;
+                    break;
+                }
+                written += copied;
+                if (!source_finished) {
+                    samples_written = written;
+                }
+                space -= copied;
+            }
+            if (copied < chunk) {
+                // no more data available now, a file has ended
+                if (file_data == nullptr) {
+                    break;
+                }
+                source_finished = true;
+                end = written;
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(period));
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Pattern_Stream::map_file(Device::Data *device_data, std::string path) {
+    /*
+        map a pattern file into memory
+
+        parameters: - device data
+                    - path to the file
+    */
+    unmap_file();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping != NULL) {
+                file_data = (const unsigned char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (file_data != nullptr) {
+                    file_handle = mapping;
+                    file_size = size.QuadPart;
+                }
+                else {
+                    CloseHandle(mapping);
+                }
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file >= 0) {
+        struct stat info;
+        if (fstat(file, &info) == 0 && info.st_size > 0) {
+            void *mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapping != MAP_FAILED) {
+                madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+                file_data = (const unsigned char *)mapping;
+                file_handle = mapping;
+                file_size = info.st_size;
+            }
+        }
+        ::close(file);
+    }
+#endif
+    if (file_data == nullptr) {
+        device_data->error.instrument = "pattern_stream";
+        device_data->error.function = "play_file";
+        device_data->error.message = "Can't map the pattern file " + path;
+        throw device_data->error;
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Pattern_Stream::unmap_file(void) {
+    /*
+        release the mapped pattern file
+    */
+    if (file_data != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(file_data);
+        CloseHandle((HANDLE)file_handle);
+#else
+        munmap(file_handle, file_size);
+#endif
+    }
+    file_data = nullptr;
+    file_handle = nullptr;
+    file_size = 0;
+    return;
+}
@@ -0,0 +1,87 @@
+/* PATTERN GENERATOR STREAMING FUNCTIONS: open, write, play_file, status, close */
+
+/* include the necessary libraries */
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include "dwf.h"
+#include "device.h"
+#include "ring.h"
+
+#ifndef WF_PATTERN_STREAM
+#define WF_PATTERN_STREAM
+namespace wf {
+
+class Pattern_Stream {
+    private:
+        class Data {
+            public:
+                int channel = 0;
+                int width = 16;
+                double frequency = 0;
+                int buffer_size = 0;
+                unsigned long long samples_written = 0;
+                unsigned long long underrun_count = 0;
+                unsigned long long underrun_samples = 0;
+                bool finished = false;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        channel = data.channel;
+                        width = data.width;
+                        frequency = data.frequency;
+                        buffer_size = data.buffer_size;
+                        samples_written = data.samples_written;
+                        underrun_count = data.underrun_count;
+                        underrun_samples = data.underrun_samples;
+                        finished = data.finished;
+                    }
+                    return *this;
+                }
+        };
+
+        // producer ring
+        Ring<unsigned short> ring;
+
+        // memory-mapped pattern file
+        const unsigned char *file_data = nullptr;
+        unsigned long long file_size = 0;
+        unsigned long long file_position = 0;
+        bool file_repeat = false;
+        void *file_handle = nullptr;
+        void map_file(Device::Data *device_data, std::string path);
+        void unmap_file(void);
+
+        // device side play buffer and feeder thread
+        std::vector<unsigned char> play_buffer;
+        std::thread feeder;
+        std::atomic<bool> running{false};
+        std::atomic<bool> failed{false};
+        std::atomic<unsigned long long> underrun_count{0};
+        std::atomic<unsigned long long> underrun_samples{0};
+        std::atomic<unsigned long long> samples_written{0};
+        std::atomic<bool> finished{false};
+        Error error;
+        HDWF handle = 0;
+        Device::Data *owner = nullptr;
+        int bytes_per_sample = 2;
+        unsigned long long fill(unsigned long long index, unsigned long long count);
+        void feed(void);
+        void stop(void);
+        void start(Device::Data *device_data, int channel, int width, double frequency, int buffer_size);
+
+    public:
+        Data data;
+        void open(Device::Data *device_data, int channel, int width, double frequency, int buffer_size = 0, int ring_size = 1 << 20);
+        int write(Device::Data *device_data, const std::vector<unsigned short> &words);
+        void play_file(Device::Data *device_data, std::string path, int channel, int width, double frequency, bool repeat = false, int buffer_size = 0);
+        Data status(void);
+        void close(Device::Data *device_data);
+        ~Pattern_Stream() {
+            stop();
+            unmap_file();
+        }
+} pattern_stream;
+
+}
+#endif
@@ -1,4 +1,4 @@
-/* PROTOCOL: I2C CONTROL FUNCTIONS: open, read, write, exchange, close */
+/* PROTOCOL: I2C CONTROL FUNCTIONS: open, read, write, exchange, try_read, try_write, try_exchange, close */
 
 /* include the header */
 #include "i2c.h"
@@ -51,18 +51,11 @@ void wf::I2C::open(Device::Data *device_data, int sda, int scl, double clk_rate,
         device.check_error(device_data);
     }
     if (nak == 0) {
-        device_data->warning.instrument = "protocol/i2c";
-        device_data->warning.function = "open";
-        device_data->warning.message = "I2C bus lockup";
-        throw device_data->warning;
+        device.check_status(device_data, Status(Status::lockup, 0, __func__, __FILE__));
     }
 
-
     // write 0 bytes
-    if (FDwfDigitalI2cWrite(device_data->handle, 0, 0, 0, &nak) == 0) {
-        device.check_error(device_data);
-    }
-    check_warning(device_data, nak);
+    device.check_status(device_data, try_write(device_data, nullptr, 0, 0, __func__));
     return;
 }
 
@@ -80,109 +73,211 @@ std::vector<unsigned char> wf::I2C::read(Device::Data *device_data, int count, i
         return:     - integer list of received data bytes
     */
     // receive
-    int nak = 0;
     std::vector<unsigned char> data(count);
-    if (FDwfDigitalI2cRead(device_data->handle, address << 1, data.data(), data.size(), &nak) == 0) {
-        device.check_error(device_data);
-    }
-
-    // check for not acknowledged
-    check_warning(device_data, nak);
+    read(device_data, data.data(), count, address);
     return data;
 }
 
 /* ----------------------------------------------------- */
 
-void wf::I2C::write(Device::Data *device_data, std::string data, int address) {
+void wf::I2C::read(Device::Data *device_data, unsigned char *data, int count, int address) {
+    /*
+        receives data from I2C into a buffer, without allocations
+
+        parameters: - device data
+                    - buffer for at least count bytes
+                    - number of bytes to receive
+                    - address (8-bit address of the slave device)
+    */
+    device.check_status(device_data, try_read(device_data, data, count, address, __func__));
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Status wf::I2C::try_read(Device::Data *device_data, unsigned char *data, int count, int address, const char *caller) {
+    /*
+        receives data from I2C into a buffer, without throwing
+
+        parameters: - device data
+                    - buffer for at least count bytes
+                    - number of bytes to receive
+                    - address (8-bit address of the slave device)
+                    - caller function name reported in the status, filled in automatically
+
+        return:     - status: ok, error, or nak with the index of the not acknowledged byte
+                      (data.time is the timestamp of the start of the transaction, see tools.timestamp)
+    */
+    int nak = 0;
+    this->data.time = tools.timestamp();
+    int result = FDwfDigitalI2cRead(device_data->handle, address << 1, data, count, &nak);
+    this->data.duration = tools.timestamp() - this->data.time;
+    if (result == 0) {
+        return device.last_status(caller, __FILE__);
+    }
+    if (nak != 0) {
+        return Status(Status::nak, nak, caller, __FILE__);
+    }
+    return Status();
+}
+
+/* ----------------------------------------------------- */
+
+void wf::I2C::write(Device::Data *device_data, const std::string &data, int address) {
     /*
         send data through I2C
         
         parameters: - device handle
-                    - data of type string, int, or list of characters/integers
+                    - data of type string, sent with its zero ending
                     - address (8-bit address of the slave device)
-                    - pointer to error string
     */
-    // encode the string into a string buffer
-    std::vector<unsigned char> buffer(data.size() + 1);
-    for (int index = 0; index < buffer.size(); index++) {
-        buffer[index] = (unsigned char)(data[index]);
-    }
-    write(device_data, buffer, address);
+    write(device_data, (const unsigned char*)data.c_str(), int(data.size()) + 1, address);
     return;
 }
 
 /* ----------------------------------------------------- */
 
-void wf::I2C::write(Device::Data *device_data, std::vector<unsigned char> data, int address) {
+void wf::I2C::write(Device::Data *device_data, const std::vector<unsigned char> &data, int address) {
     /*
         send data through I2C
         
         parameters: - device handle
-                    - data of type string, int, or list of characters/integers
+                    - data of type list of characters/integers
                     - address (8-bit address of the slave device)
-                    - pointer to error string
     */
-    // send
-    int nak = 0;
-    if (FDwfDigitalI2cWrite(device_data->handle, address << 1, data.data(), data.size(), &nak) == 0) {
-        device.check_error(device_data);
-    }
+    write(device_data, data.data(), int(data.size()), address);
+    return;
+}
 
-    // check for not acknowledged
-    check_warning(device_data, nak);
+/* ----------------------------------------------------- */
+
+void wf::I2C::write(Device::Data *device_data, const unsigned char *data, int count, int address) {
+    /*
+        send data through I2C from a buffer, without copying it
+
+        parameters: - device data
+                    - buffer of the data bytes
+                    - number of bytes to send
+                    - address (8-bit address of the slave device)
+    */
+    device.check_status(device_data, try_write(device_data, data, count, address, __func__));
     return;
 }
 
 /* ----------------------------------------------------- */
 
-std::vector<unsigned char> wf::I2C::exchange(Device::Data *device_data, std::string tx_data, int count, int address) {
+wf::Status wf::I2C::try_write(Device::Data *device_data, const unsigned char *data, int count, int address, const char *caller) {
+    /*
+        send data through I2C from a buffer, without throwing
+
+        parameters: - device data
+                    - buffer of the data bytes
+                    - number of bytes to send
+                    - address (8-bit address of the slave device)
+                    - caller function name reported in the status, filled in automatically
+
+        return:     - status: ok, error, or nak with the index of the not acknowledged byte
+                      (data.time is the timestamp of the start of the transaction, see tools.timestamp)
+    */
+    int nak = 0;
+    this->data.time = tools.timestamp();
+    int result = FDwfDigitalI2cWrite(device_data->handle, address << 1, const_cast<unsigned char*>(data), count, &nak);
+    this->data.duration = tools.timestamp() - this->data.time;
+    if (result == 0) {
+        return device.last_status(caller, __FILE__);
+    }
+    if (nak != 0) {
+        return Status(Status::nak, nak, caller, __FILE__);
+    }
+    return Status();
+}
+
+/* ----------------------------------------------------- */
+
+std::vector<unsigned char> wf::I2C::exchange(Device::Data *device_data, const std::string &tx_data, int count, int address) {
     /*
         sends and receives data using the I2C interface
         
         parameters: - device handle
-                    - data of type string, int, or list of characters/integers
+                    - data of type string, sent with its zero ending
                     - number of bytes to receive
                     - address (8-bit address of the slave device)
-                    - pointer to error string
         
         return:     - integer list of received bytes
     */
-    // encode the string into a string buffer
-    std::vector<unsigned char> buffer(tx_data.size() + 1);
-    for (int index = 0; index < buffer.size(); index++) {
-        buffer[index] = (unsigned char)(tx_data[index]);
-    }
-
-    return exchange(device_data, buffer, count, address);
+    std::vector<unsigned char> rx_data(count);
+    exchange(device_data, (const unsigned char*)tx_data.c_str(), int(tx_data.size()) + 1, rx_data.data(), count, address);
+    return rx_data;
 }
 
 /* ----------------------------------------------------- */
 
-std::vector<unsigned char> wf::I2C::exchange(Device::Data *device_data, std::vector<unsigned char> tx_data, int count, int address) {
+std::vector<unsigned char> wf::I2C::exchange(Device::Data *device_data, const std::vector<unsigned char> &tx_data, int count, int address) {
     /*
         sends and receives data using the I2C interface
         
         parameters: - device handle
-                    - data of type string, int, or list of characters/integers
+                    - data of type list of characters/integers
                     - number of bytes to receive
                     - address (8-bit address of the slave device)
         
         return:     - integer list of received bytes
     */
     // send and receive
-    int nak = 0;
     std::vector<unsigned char> rx_data(count);
-    if (FDwfDigitalI2cWriteRead(device_data->handle, address << 1, tx_data.data(), tx_data.size(), rx_data.data(), rx_data.size(), &nak) == 0) {
-        device.check_error(device_data);
-    }
-
-    // check for not acknowledged
-    check_warning(device_data, nak);
+    exchange(device_data, tx_data.data(), int(tx_data.size()), rx_data.data(), count, address);
     return rx_data;
 }
 
 /* ----------------------------------------------------- */
 
+void wf::I2C::exchange(Device::Data *device_data, const unsigned char *tx_data, int tx_count, unsigned char *rx_data, int rx_count, int address) {
+    /*
+        sends and receives data using the I2C interface, with caller provided buffers
+
+        parameters: - device data
+                    - buffer of the data bytes to send
+                    - number of bytes to send
+                    - buffer for at least rx_count bytes
+                    - number of bytes to receive
+                    - address (8-bit address of the slave device)
+    */
+    device.check_status(device_data, try_exchange(device_data, tx_data, tx_count, rx_data, rx_count, address, __func__));
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Status wf::I2C::try_exchange(Device::Data *device_data, const unsigned char *tx_data, int tx_count, unsigned char *rx_data, int rx_count, int address, const char *caller) {
+    /*
+        sends and receives data using the I2C interface, without throwing
+
+        parameters: - device data
+                    - buffer of the data bytes to send
+                    - number of bytes to send
+                    - buffer for at least rx_count bytes
+                    - number of bytes to receive
+                    - address (8-bit address of the slave device)
+                    - caller function name reported in the status, filled in automatically
+
+        return:     - status: ok, error, or nak with the index of the not acknowledged byte
+                      (data.time is the timestamp of the start of the transaction, see tools.timestamp)
+    */
+    int nak = 0;
+    this->data.time = tools.timestamp();
+    int result = FDwfDigitalI2cWriteRead(device_data->handle, address << 1, const_cast<unsigned char*>(tx_data), tx_count, rx_data, rx_count, &nak);
+    this->data.duration = tools.timestamp() - this->data.time;
+    if (result == 0) {
+        return device.last_status(caller, __FILE__);
+    }
+    if (nak != 0) {
+        return Status(Status::nak, nak, caller, __FILE__);
+    }
+    return Status();
+}
+
+/* ----------------------------------------------------- */
+
 //std::string wf::I2C::spy(Device::Data device_data, int count, std::string *error) {
     /*
         receives data from I2C
@@ -250,27 +345,45 @@ std::vector<unsigned char> wf::I2C::exchange(Device::Data *device_data, std::vec
 
 /* ----------------------------------------------------- */
 
-void wf::I2C::close(Device::Data *device_data) {
+#if __cplusplus >= 202002L
+void wf::I2C::read(Device::Data *device_data, std::span<std::byte> data, int address) {
     /*
-        reset the i2c interface
+        receives data from I2C into a caller provided span, its size is the number of bytes
     */
-    if (FDwfDigitalI2cReset(device_data->handle) == 0) {
-        device.check_error(device_data);
-    }
+    read(device_data, reinterpret_cast<unsigned char*>(data.data()), int(data.size()), address);
     return;
 }
 
 /* ----------------------------------------------------- */
 
-void wf::I2C::check_warning(Device::Data *device_data, int nak, const char *caller) {
+void wf::I2C::write(Device::Data *device_data, std::span<const std::byte> data, int address) {
     /*
-        check for I2C errors
+        send the bytes of a span through I2C
     */
-    if (nak != 0) {
-        device_data->warning.instrument = "protocol/i2c";
-        device_data->warning.function = caller;
-        device_data->warning.message = " -> NAK: index " + std::to_string(nak);
-        throw device_data->warning;
+    write(device_data, reinterpret_cast<const unsigned char*>(data.data()), int(data.size()), address);
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::I2C::exchange(Device::Data *device_data, std::span<const std::byte> tx_data, std::span<std::byte> rx_data, int address) {
+    /*
+        send the bytes of a span and receive into another one, its size is the number of received bytes
+    */
+    exchange(device_data, reinterpret_cast<const unsigned char*>(tx_data.data()), int(tx_data.size()),
+             reinterpret_cast<unsigned char*>(rx_data.data()), int(rx_data.size()), address);
+    return;
+}
+
+/* ----------------------------------------------------- */
+#endif
+
+void wf::I2C::close(Device::Data *device_data) {
+    /*
+        reset the i2c interface
+    */
+    if (FDwfDigitalI2cReset(device_data->handle) == 0) {
+        device.check_error(device_data);
     }
     return;
 }
@@ -1,11 +1,16 @@
-/* PROTOCOL: I2C CONTROL FUNCTIONS: open, read, write, exchange, close */
+/* PROTOCOL: I2C CONTROL FUNCTIONS: open, read, write, exchange, try_read, try_write, try_exchange, close */
 
 /* include the necessary libraries */
 #include <string>
 #include <vector>
 #include <cstdio>
+#if __cplusplus >= 202002L
+#include <span>
+#include <cstddef>
+#endif
 #include "dwf.h"
 #include "../device.h"
+#include "../tools.h"
 
 #ifndef WF_PROTOCOL_I2C
 #define WF_PROTOCOL_I2C
@@ -13,7 +18,18 @@ namespace wf {
 
 class I2C {
     private:
-        void check_warning(Device::Data *device_data, int nak, const char *caller = __builtin_FUNCTION());
+        class Data {
+            public:
+                long long time = 0;
+                long long duration = 0;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        time = data.time;
+                        duration = data.duration;
+                    }
+                    return *this;
+                }
+        };
         /*class Data {
             public:
                 std::vector<unsigned char> data;
@@ -35,12 +51,24 @@ class I2C {
         };*/
 
     public:
+        Data data;
         void open(Device::Data *device_data, int sda, int scl, double clk_rate = 100e03, bool stretching = true);
         std::vector<unsigned char> read(Device::Data *device_data, int count, int address);
-        void write(Device::Data *device_data, std::string data, int address);
-        void write(Device::Data *device_data, std::vector<unsigned char> data, int address);
-        std::vector<unsigned char> exchange(Device::Data *device_data, std::string tx_data, int count, int address);
-        std::vector<unsigned char> exchange(Device::Data *device_data, std::vector<unsigned char> tx_data, int count, int address);
+        void read(Device::Data *device_data, unsigned char *data, int count, int address);
+        void write(Device::Data *device_data, const std::string &data, int address);
+        void write(Device::Data *device_data, const std::vector<unsigned char> &data, int address);
+        void write(Device::Data *device_data, const unsigned char *data, int count, int address);
+        std::vector<unsigned char> exchange(Device::Data *device_data, const std::string &tx_data, int count, int address);
+        std::vector<unsigned char> exchange(Device::Data *device_data, const std::vector<unsigned char> &tx_data, int count, int address);
+        void exchange(Device::Data *device_data, const unsigned char *tx_data, int tx_count, unsigned char *rx_data, int rx_count, int address);
+        Status try_read(Device::Data *device_data, unsigned char *data, int count, int address, const char *caller = __builtin_FUNCTION());
+        Status try_write(Device::Data *device_data, const unsigned char *data, int count, int address, const char *caller = __builtin_FUNCTION());
+        Status try_exchange(Device::Data *device_data, const unsigned char *tx_data, int tx_count, unsigned char *rx_data, int rx_count, int address, const char *caller = __builtin_FUNCTION());
+#if __cplusplus >= 202002L
+        void read(Device::Data *device_data, std::span<std::byte> data, int address);
+        void write(Device::Data *device_data, std::span<const std::byte> data, int address);
+        void exchange(Device::Data *device_data, std::span<const std::byte> tx_data, std::span<std::byte> rx_data, int address);
+#endif
         //std::vector<unsigned char> spy(Device::Data device_data, int count = 16);
         void close(Device::Data *device_data);
 } i2c;
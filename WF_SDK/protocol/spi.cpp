@@ -86,16 +86,30 @@ std::vector<unsigned char> wf::SPI::read(Device::Data *device_data, int count, i
 
         return:     - integer list containing the received bytes
     */
+    // create buffer to store data
+    std::vector<unsigned char> buffer(count);
+    read(device_data, buffer.data(), count, cs);
+    return buffer;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::SPI::read(Device::Data *device_data, unsigned char *data, int count, int cs) {
+    /*
+        receives data from SPI into a buffer, without allocations
+
+        parameters: - device handle
+                    - buffer for at least count bytes
+                    - count (number of bytes to receive)
+                    - chip select line number
+    */
     // enable the chip select line
     if (FDwfDigitalSpiSelect(device_data->handle, cs, 0) == 0) {
         device.check_error(device_data);
     }
 
-    // create buffer to store data
-    std::vector<unsigned char> buffer(count);
-
     // read array of 8 bit elements
-    if (FDwfDigitalSpiRead(device_data->handle, 1, 8, buffer.data(), buffer.size()) == 0) {
+    if (FDwfDigitalSpiRead(device_data->handle, 1, 8, data, count) == 0) {
         device.check_error(device_data);
     }
 
@@ -103,32 +117,26 @@ std::vector<unsigned char> wf::SPI::read(Device::Data *device_data, int count, i
     if (FDwfDigitalSpiSelect(device_data->handle, cs, 1) == 0) {
         device.check_error(device_data);
     }
-
-    return buffer;
+    return;
 }
 
 /* ----------------------------------------------------- */
 
-void wf::SPI::write(Device::Data *device_data, std::string data, int cs) {
+void wf::SPI::write(Device::Data *device_data, const std::string &data, int cs) {
     /*
         send data through SPI
 
         parameters: - device handle
-                    - data of type string
+                    - data of type string, sent with its zero ending
                     - chip select line number
     */
-    // create buffer to write
-    std::vector<unsigned char> buffer(data.size() + 1);
-    for (int index = 0; index < buffer.size(); index++) {
-        buffer[index] = (unsigned char)(data[index]);
-    }
-    write(device_data, buffer, cs);
+    write(device_data, (const unsigned char*)data.c_str(), int(data.size()) + 1, cs);
     return;
 }
 
 /* ----------------------------------------------------- */
 
-void wf::SPI::write(Device::Data *device_data, std::vector<unsigned char> data, int cs) {
+void wf::SPI::write(Device::Data *device_data, const std::vector<unsigned char> &data, int cs) {
     /*
         send data through SPI
 
@@ -136,13 +144,28 @@ void wf::SPI::write(Device::Data *device_data, std::vector<unsigned char> data,
                     - data of type list of characters/integers
                     - chip select line number
     */
+    write(device_data, data.data(), int(data.size()), cs);
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::SPI::write(Device::Data *device_data, const unsigned char *data, int count, int cs) {
+    /*
+        send data through SPI from a buffer, without copying it
+
+        parameters: - device handle
+                    - buffer of the data bytes
+                    - number of bytes to send
+                    - chip select line number
+    */
     // enable the chip select line
     if (FDwfDigitalSpiSelect(device_data->handle, cs, 0) == 0) {
         device.check_error(device_data);
     }
 
     // write array of 8 bit elements
-    if (FDwfDigitalSpiWrite(device_data->handle, 1, 8, data.data(), data.size()) == 0) {
+    if (FDwfDigitalSpiWrite(device_data->handle, 1, 8, const_cast<unsigned char*>(data), count) == 0) {
         device.check_error(device_data);
     }
 
@@ -155,28 +178,25 @@ void wf::SPI::write(Device::Data *device_data, std::vector<unsigned char> data,
 
 /* ----------------------------------------------------- */
 
-std::vector<unsigned char> wf::SPI::exchange(Device::Data *device_data, std::string tx_data, int count, int cs) {
+std::vector<unsigned char> wf::SPI::exchange(Device::Data *device_data, const std::string &tx_data, int count, int cs) {
     /*
         sends and receives data using the SPI interface
         
         parameters: - device handle
-                    - data of type string
+                    - data of type string, sent with its zero ending
                     - count (number of bytes to receive)
                     - chip select line number
         
         return:     - integer list containing the received bytes
     */
-    // create buffer to write
-    std::vector<unsigned char> buffer(tx_data.size() + 1);
-    for (int index = 0; index < buffer.size(); index++) {
-        buffer[index] = (unsigned char)(tx_data[index]);
-    }
-    return exchange(device_data, buffer, count, cs);
+    std::vector<unsigned char> rx_data(count);
+    exchange(device_data, (const unsigned char*)tx_data.c_str(), int(tx_data.size()) + 1, rx_data.data(), count, cs);
+    return rx_data;
 }
 
 /* ----------------------------------------------------- */
 
-std::vector<unsigned char> wf::SPI::exchange(Device::Data *device_data, std::vector<unsigned char> tx_data, int count, int cs) {
+std::vector<unsigned char> wf::SPI::exchange(Device::Data *device_data, const std::vector<unsigned char> &tx_data, int count, int cs) {
     /*
         sends and receives data using the SPI interface
         
@@ -187,16 +207,31 @@ std::vector<unsigned char> wf::SPI::exchange(Device::Data *device_data, std::vec
         
         return:     - integer list containing the received bytes
     */
+    std::vector<unsigned char> rx_data(count);
+    exchange(device_data, tx_data.data(), int(tx_data.size()), rx_data.data(), count, cs);
+    return rx_data;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::SPI::exchange(Device::Data *device_data, const unsigned char *tx_data, int tx_count, unsigned char *rx_data, int rx_count, int cs) {
+    /*
+        sends and receives data using the SPI interface, with caller provided buffers
+
+        parameters: - device handle
+                    - buffer of the data bytes to send
+                    - number of bytes to send
+                    - buffer for at least rx_count bytes
+                    - number of bytes to receive
+                    - chip select line number
+    */
     // enable the chip select line
     if (FDwfDigitalSpiSelect(device_data->handle, cs, 0) == 0) {
         device.check_error(device_data);
     }
 
-    // create buffer to store data
-    std::vector<unsigned char> rx_data(count);
-
     // write to MOSI and read from MISO
-    if (FDwfDigitalSpiWriteRead(device_data->handle, 1, 8, tx_data.data(), tx_data.size(), rx_data.data(), rx_data.size()) == 0) {
+    if (FDwfDigitalSpiWriteRead(device_data->handle, 1, 8, const_cast<unsigned char*>(tx_data), tx_count, rx_data, rx_count) == 0) {
         device.check_error(device_data);
     }
 
@@ -204,12 +239,43 @@ std::vector<unsigned char> wf::SPI::exchange(Device::Data *device_data, std::vec
     if (FDwfDigitalSpiSelect(device_data->handle, cs, 1) == 0) {
         device.check_error(device_data);
     }
+    return;
+}
 
-    // decode data
-    return rx_data;
+/* ----------------------------------------------------- */
+
+#if __cplusplus >= 202002L
+void wf::SPI::read(Device::Data *device_data, std::span<std::byte> data, int cs) {
+    /*
+        receives data from SPI into a caller provided span, its size is the number of bytes
+    */
+    read(device_data, reinterpret_cast<unsigned char*>(data.data()), int(data.size()), cs);
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::SPI::write(Device::Data *device_data, std::span<const std::byte> data, int cs) {
+    /*
+        send the bytes of a span through SPI
+    */
+    write(device_data, reinterpret_cast<const unsigned char*>(data.data()), int(data.size()), cs);
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::SPI::exchange(Device::Data *device_data, std::span<const std::byte> tx_data, std::span<std::byte> rx_data, int cs) {
+    /*
+        send the bytes of a span and receive into another one, its size is the number of received bytes
+    */
+    exchange(device_data, reinterpret_cast<const unsigned char*>(tx_data.data()), int(tx_data.size()),
+             reinterpret_cast<unsigned char*>(rx_data.data()), int(rx_data.size()), cs);
+    return;
 }
 
 /* ----------------------------------------------------- */
+#endif
 
 //spi_data wf::SPI::spy(Device::Data device_data, int count, int cs, int sck, int mosi, int miso, int word_size) {
     /*
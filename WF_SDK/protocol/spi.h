@@ -3,6 +3,10 @@
 /* include the necessary libraries */
 #include <string>
 #include <vector>
+#if __cplusplus >= 202002L
+#include <span>
+#include <cstddef>
+#endif
 #include "dwf.h"
 #include "../device.h"
 
@@ -16,10 +20,18 @@ class SPI {
     public:
         void open(Device::Data *device_data, int cs, int sck, int miso = -1, int mosi = -1, double clk_frequency = 1e06, int mode = 0, bool order = true);
         std::vector<unsigned char> read(Device::Data *device_data, int count, int cs);
-        void write(Device::Data *device_data, std::string data, int cs);
-        void write(Device::Data *device_data, std::vector<unsigned char> data, int cs);
-        std::vector<unsigned char> exchange(Device::Data *device_data, std::string tx_data, int count, int cs);
-        std::vector<unsigned char> exchange(Device::Data *device_data, std::vector<unsigned char> tx_data, int count, int cs);
+        void read(Device::Data *device_data, unsigned char *data, int count, int cs);
+        void write(Device::Data *device_data, const std::string &data, int cs);
+        void write(Device::Data *device_data, const std::vector<unsigned char> &data, int cs);
+        void write(Device::Data *device_data, const unsigned char *data, int count, int cs);
+        std::vector<unsigned char> exchange(Device::Data *device_data, const std::string &tx_data, int count, int cs);
+        std::vector<unsigned char> exchange(Device::Data *device_data, const std::vector<unsigned char> &tx_data, int count, int cs);
+        void exchange(Device::Data *device_data, const unsigned char *tx_data, int tx_count, unsigned char *rx_data, int rx_count, int cs);
+#if __cplusplus >= 202002L
+        void read(Device::Data *device_data, std::span<std::byte> data, int cs);
+        void write(Device::Data *device_data, std::span<const std::byte> data, int cs);
+        void exchange(Device::Data *device_data, std::span<const std::byte> tx_data, std::span<std::byte> rx_data, int cs);
+#endif
         //spi_data spy(Device::Data device_data, int count, int cs, int sck, int mosi = -1, int miso = -1, int word_size = 8);
         void close(Device::Data *device_data);
 } spi;
@@ -1,4 +1,4 @@
-/* PROTOCOL: UART CONTROL FUNCTIONS: open, read, write, close */
+/* PROTOCOL: UART CONTROL FUNCTIONS: open, read, write, try_read, try_write, close */
 
 /* include the header */
 #include "uart.h"
@@ -17,6 +17,10 @@ void wf::UART::open(Device::Data *device_data, int rx, int tx, int baud_rate, bo
                     - data_bits (default is 8)
                     - stop_bits (default is 1)
     */
+    // get the digital input information, it is needed to size the receive buffer
+    device.get_info(device_data, device.info.digital_input);
+    rx_buffer.resize(device_data->digital.input.max_buffer_size > 1 ? device_data->digital.input.max_buffer_size : 8192);
+
     // set baud rate
     if (FDwfDigitalUartRateSet(device_data->handle, double(baud_rate)) == 0) {
         device.check_error(device_data);
@@ -83,101 +87,200 @@ std::vector<unsigned char> wf::UART::read(Device::Data *device_data) {
 
         return:     - integer list containing the received bytes
                     - error message or empty string
+                      (data.rx_time is the timestamp of the received chunk, see tools.timestamp)
     */
-    // variable to store results
-    std::vector<char> rx_data(device_data->digital.input.max_buffer_size);
-    std::vector<unsigned char> data;
-
-    // character counter
-    int count = 0;
-
-    // parity flag
-    int parity_flag = 0;
-
-    // read up to 8k characters
-    if (FDwfDigitalUartRx(device_data->handle, rx_data.data(), rx_data.size() - 1, &count, &parity_flag) == 0) {
-        device.check_error(device_data);
-    }
-
-    // append current data chunks
-    int index = 0;
-    for (index = 0; index < count; index++) {
-        data.insert(data.end(), (unsigned char)(rx_data[index]));
+    // the receive buffer is reused, the result grows by whole chunks
+    if (rx_buffer.size() < 2) {
+        rx_buffer.resize(device_data->digital.input.max_buffer_size > 1 ? device_data->digital.input.max_buffer_size : 8192);
     }
+    std::vector<unsigned char> data;
 
-    // ensure data integrity
+    // read until the receive buffer of the device is empty
+    long long time = tools.timestamp();
+    int count = 1;
     while (count > 0) {
         // reset character counter
         count = 0;
 
         // parity flag
-        parity_flag = 0;
+        int parity_flag = 0;
 
         // read up to 8k characters
-        if (FDwfDigitalUartRx(device_data->handle, rx_data.data(), rx_data.size() - 1, &count, &parity_flag) == 0) {
+        if (FDwfDigitalUartRx(device_data->handle, rx_buffer.data(), rx_buffer.size() - 1, &count, &parity_flag) == 0) {
             device.check_error(device_data);
         }
 
         // append current data chunks
-        for ( ; index < count; index++) {
-            data.insert(data.end(), (unsigned char)(rx_data[index]));
-        }
+        data.insert(data.end(), (unsigned char*)rx_buffer.data(), (unsigned char*)rx_buffer.data() + count);
 
         // check for not acknowledged
         if (parity_flag < 0) {
-            device_data->warning.instrument = "protocol/uart";
-            device_data->warning.function = "read";
-            device_data->warning.message = "Buffer overflow";
-            throw device_data->warning;
+            device.check_status(device_data, Status(Status::overflow, 0, __func__, __FILE__));
         }
         else if (parity_flag > 0) {
-            device_data->warning.instrument = "protocol/uart";
-            device_data->warning.function = "read";
-            device_data->warning.message = "Parity error: index " + std::to_string(parity_flag);
-            throw device_data->warning;
+            device.check_status(device_data, Status(Status::parity, parity_flag, __func__, __FILE__));
         }
     }
+    if (data.size() > 0) {
+        this->data.rx_time = time;
+        this->data.rx_count = data.size();
+    }
     return data;
 }
 
 /* ----------------------------------------------------- */
 
-void wf::UART::write(Device::Data *device_data, std::string data) {
+int wf::UART::read(Device::Data *device_data, unsigned char *data, int size) {
+    /*
+        receives data from UART into a buffer, without allocations
+
+        parameters: - device data
+                    - buffer for at most size bytes
+                    - size of the buffer
+
+        return:     - the number of received bytes, the device is read until it is empty or the buffer is full
+                      (data.rx_time is the timestamp of the received data, see tools.timestamp)
+    */
+    long long time = tools.timestamp();
+    int received = 0;
+    int count = 1;
+    while (count > 0 && received < size) {
+        count = 0;
+        int parity_flag = 0;
+        if (FDwfDigitalUartRx(device_data->handle, (char*)data + received, size - received, &count, &parity_flag) == 0) {
+            device.check_error(device_data);
+        }
+        received += count;
+
+        // check for not acknowledged
+        if (parity_flag < 0) {
+            device.check_status(device_data, Status(Status::overflow, 0, __func__, __FILE__));
+        }
+        else if (parity_flag > 0) {
+            device.check_status(device_data, Status(Status::parity, parity_flag, __func__, __FILE__));
+        }
+    }
+    if (received > 0) {
+        this->data.rx_time = time;
+        this->data.rx_count = received;
+    }
+    return received;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Status wf::UART::try_read(Device::Data *device_data, unsigned char *data, int size, int *count) {
+    /*
+        receives the available data from UART into a buffer, without throwing
+
+        parameters: - device data
+                    - buffer for at most size bytes
+                    - size of the buffer
+                    - pointer to the number of received bytes
+
+        return:     - status: ok, error, overflow, or parity with the index of the wrong byte
+                      (data.rx_time is the timestamp of the received chunk, see tools.timestamp)
+    */
+    int parity_flag = 0;
+    *count = 0;
+    long long time = tools.timestamp();
+    if (FDwfDigitalUartRx(device_data->handle, (char*)data, size, count, &parity_flag) == 0) {
+        return device.last_status();
+    }
+    if (*count > 0) {
+        this->data.rx_time = time;
+        this->data.rx_count = *count;
+    }
+    if (parity_flag < 0) {
+        return Status(Status::overflow, 0, __func__, __FILE__);
+    }
+    else if (parity_flag > 0) {
+        return Status(Status::parity, parity_flag, __func__, __FILE__);
+    }
+    return Status();
+}
+
+/* ----------------------------------------------------- */
+
+void wf::UART::write(Device::Data *device_data, const std::string &data) {
     /*
         send data through UART
         
-        parameters: - data of type string
+        parameters: - data of type string, sent with its zero ending
     */
-    //  create buffer to write
-    std::vector<unsigned char> buffer(data.size() + 1);
-    for (int index = 0; index < buffer.size(); index++) {
-        buffer[index] = (unsigned char)(data[index]);
-    }
-    write(device_data, buffer);
+    write(device_data, (const unsigned char*)data.c_str(), int(data.size()) + 1);
     return;
 }
 
 /* ----------------------------------------------------- */
 
-void wf::UART::write(Device::Data *device_data, std::vector<unsigned char> data) {
+void wf::UART::write(Device::Data *device_data, const std::vector<unsigned char> &data) {
     /*
         send data through UART
         
         parameters: - data of type array of integers
     */
-    // encode the string into a C string
-    std::vector<char> buffer(data.size() + 1);
-    for (int index = 0; index < buffer.size(); index++) {
-        buffer[index] = (char)(data[index]);
-    }
-    // send text, trim zero ending
-    if (FDwfDigitalUartTx(device_data->handle, buffer.data(), buffer.size() - 1) == 0) {
-        device.check_error(device_data);
+    write(device_data, data.data(), int(data.size()));
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::UART::write(Device::Data *device_data, const unsigned char *data, int count) {
+    /*
+        send data through UART from a buffer, without copying it
+
+        parameters: - device data
+                    - buffer of the data bytes
+                    - number of bytes to send
+    */
+    device.check_status(device_data, try_write(device_data, data, count));
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Status wf::UART::try_write(Device::Data *device_data, const unsigned char *data, int count) {
+    /*
+        send data through UART from a buffer, without throwing
+
+        parameters: - device data
+                    - buffer of the data bytes
+                    - number of bytes to send
+
+        return:     - status: ok or error
+    */
+    this->data.tx_time = tools.timestamp();
+    if (FDwfDigitalUartTx(device_data->handle, (char*)data, count) == 0) {
+        return device.last_status();
     }
+    return Status();
+}
+
+/* ----------------------------------------------------- */
+
+#if __cplusplus >= 202002L
+int wf::UART::read(Device::Data *device_data, std::span<std::byte> data) {
+    /*
+        receives data from UART into a caller provided span
+
+        return:     - the number of received bytes
+    */
+    return read(device_data, reinterpret_cast<unsigned char*>(data.data()), int(data.size()));
+}
+
+/* ----------------------------------------------------- */
+
+void wf::UART::write(Device::Data *device_data, std::span<const std::byte> data) {
+    /*
+        send the bytes of a span through UART
+    */
+    write(device_data, reinterpret_cast<const unsigned char*>(data.data()), int(data.size()));
     return;
 }
 
 /* ----------------------------------------------------- */
+#endif
 
 void wf::UART::close(Device::Data *device_data) {
     /*
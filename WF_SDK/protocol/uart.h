@@ -1,21 +1,53 @@
-/* PROTOCOL: UART CONTROL FUNCTIONS: open, read, write, close */
+/* PROTOCOL: UART CONTROL FUNCTIONS: open, read, write, try_read, try_write, close */
 
 /* include the necessary libraries */
 #include <string>
 #include <vector>
+#if __cplusplus >= 202002L
+#include <span>
+#include <cstddef>
+#endif
 #include "dwf.h"
 #include "../device.h"
+#include "../tools.h"
 
 #ifndef WF_PROTOCOL_UART
 #define WF_PROTOCOL_UART
 namespace wf {
 
 class UART {
+    private:
+        class Data {
+            public:
+                long long rx_time = 0;
+                int rx_count = 0;
+                long long tx_time = 0;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        rx_time = data.rx_time;
+                        rx_count = data.rx_count;
+                        tx_time = data.tx_time;
+                    }
+                    return *this;
+                }
+        };
+
+        std::vector<char> rx_buffer;    // receive buffer, allocated once in open
+
     public:
+        Data data;
         void open(Device::Data *device_data, int rx, int tx, int baud_rate = 9600, bool parity = bool(-1), int data_bits = 8, int stop_bits = 1);
         std::vector<unsigned char> read(Device::Data *device_data);
-        void write(Device::Data *device_data, std::string data);
-        void write(Device::Data *device_data, std::vector<unsigned char> data);
+        int read(Device::Data *device_data, unsigned char *data, int size);
+        void write(Device::Data *device_data, const std::string &data);
+        void write(Device::Data *device_data, const std::vector<unsigned char> &data);
+        void write(Device::Data *device_data, const unsigned char *data, int count);
+#if __cplusplus >= 202002L
+        int read(Device::Data *device_data, std::span<std::byte> data);
+        void write(Device::Data *device_data, std::span<const std::byte> data);
+#endif
+        Status try_read(Device::Data *device_data, unsigned char *data, int size, int *count);
+        Status try_write(Device::Data *device_data, const unsigned char *data, int count);
         void close(Device::Data *device_data);
 } uart;
 
@@ -0,0 +1,199 @@
+/* PROTOCOL: UART RECEIVE STREAMING FUNCTIONS: start, read, timestamps, status, stop */
+
+/* include the header */
+#include "uart_stream.h"
+
+/* ----------------------------------------------------- */
+
+void wf::UART_Stream::start(Device::Data *device_data, int ring_size, double interval) {
+    /*
+        receive UART data on a background thread, open the interface with uart.open first
+
+        parameters: - device data
+                    - ring_size - number of bytes kept until read, default is 1MB
+                    - interval - wait between two empty polls in seconds, default is 0.5ms,
+                                 the device buffer has to be drained before it fills at the baud rate
+    */
+    stop(device_data);
+
+    // every buffer is allocated here, the poller doesn't allocate
+    device.get_info(device_data, device.info.digital_input);
+    buffer.resize(device_data->digital.input.max_buffer_size > 1 ? device_data->digital.input.max_buffer_size : 8192);
+    bytes.resize(ring_size);
+    chunks.resize(ring_size / 16 > 256 ? ring_size / 16 : 256);
+    handle = device_data->handle;
+    this->interval = std::chrono::nanoseconds((long long)(interval * 1e09));
+
+    received = 0;
+    overflows = 0;
+    parity_errors = 0;
+    polls = 0;
+    last_time = 0;
+    data = Data();
+    failed = false;
+    running = true;
+    poller = std::thread(&UART_Stream::poll, this);
+
+    // device.close stops the poller before the handle is closed
+    owner = device_data;
+    owner->engines[this] = [this]() {
+        stop(nullptr);
+    };
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+int wf::UART_Stream::read(Device::Data *device_data, unsigned char *data, int size, double timeout) {
+    /*
+        take received bytes, waiting for them if needed
+
+        parameters: - device data
+                    - buffer for at most size bytes
+                    - size of the buffer
+                    - timeout - the longest wait for size bytes in seconds, default is 0 (no wait)
+
+        returns:    - number of bytes copied, less than size if the timeout expired
+    */
+    if (timeout > 0) {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeout));
+        std::unique_lock<std::mutex> guard(lock);
+        arrived.wait_until(guard, deadline, [&]() {
+            return bytes.size() >= size_t(size) || failed || !running;
+        });
+    }
+    if (failed && bytes.size() == 0) {
+        device_data->error = error;
+        throw device_data->error;
+    }
+    return int(bytes.pop(data, size));
+}
+
+/* ----------------------------------------------------- */
+
+std::vector<unsigned char> wf::UART_Stream::read(Device::Data *device_data, int size, double timeout) {
+    /*
+        take received bytes, waiting for them if needed
+
+        parameters: - device data
+                    - size - maximum number of bytes, 0 means every received byte
+                    - timeout - the longest wait for size bytes in seconds, default is 0 (no wait)
+
+        returns:    - list of the received bytes
+    */
+    std::vector<unsigned char> result(size > 0 ? size : bytes.size());
+    result.resize(read(device_data, result.data(), int(result.size()), timeout));
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+std::vector<wf::UART_Stream::Chunk> wf::UART_Stream::timestamps(int max_count) {
+    /*
+        take the timestamps of the received chunks, they are kept separately from the bytes
+
+        parameters: - max_count - maximum number of chunks, default is 0 (every stored chunk)
+
+        returns:    - list of chunks: time (steady clock nanoseconds), stream position of the first byte, byte count
+    */
+    size_t count = chunks.size();
+    if (max_count > 0 && size_t(max_count) < count) {
+        count = max_count;
+    }
+    std::vector<Chunk> result(count);
+    result.resize(chunks.pop(result.data(), count));
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+wf::UART_Stream::Data wf::UART_Stream::status(void) {
+    /*
+        returns:    - received and dropped bytes, device overflows, parity errors, polls and the time of the last chunk
+    */
+    data.bytes = received;
+    data.dropped_bytes = bytes.drop_count();
+    data.overflows = overflows;
+    data.parity_errors = parity_errors;
+    data.polls = polls;
+    data.last_time = last_time;
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::UART_Stream::stop(Device::Data*) {
+    /*
+        stop the receiver thread, the bytes in the ring can still be read
+    */
+    running = false;
+    arrived.notify_all();
+    if (poller.joinable()) {
+        poller.join();
+    }
+    if (owner != nullptr) {
+        owner->engines.erase(this);
+        owner = nullptr;
+    }
+    status();
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::UART_Stream::poll(void) {
+    /*
+        receiver thread: drain the device buffer into the ring, sleep only when it was empty
+    */
+    while (running) {
+        int count = 0;
+        int parity_flag = 0;
+        long long time = tools.timestamp();
+        if (FDwfDigitalUartRx(handle, buffer.data(), int(buffer.size()) - 1, &count, &parity_flag) == 0) {
+            char message[512];
+            FDwfGetLastErrorMsg(message);
+            error.instrument = "uart_stream";
+            error.function = "poll";
+            error.message = message;
+            failed = true;
+            break;
+        }
+        polls++;
+
+        // the flags are counted, the bytes are kept
+        if (parity_flag < 0) {
+            overflows++;
+        }
+        else if (parity_flag > 0) {
+            parity_errors++;
+        }
+
+        if (count > 0) {
+            Chunk chunk;
+            chunk.time = time;
+            chunk.first = received;
+            chunk.count = count;
+            chunks.push(chunk);
+            bytes.push((const unsigned char*)buffer.data(), count);
+            received += count;
+            last_time = time;
+
+            // wake up the waiting reader, the lock makes sure the wakeup isn't lost
+            {
+                std::lock_guard<std::mutex> guard(lock);
+            }
+            arrived.notify_all();
+        }
+        else {
+            std::this_thread::sleep_for(interval);
+        }
+    }
+
+    // wake up a waiting reader
+    {
+        std::lock_guard<std::mutex> guard(lock);
+    }
+    arrived.notify_all();
+    return;
+}
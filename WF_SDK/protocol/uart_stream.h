@@ -0,0 +1,84 @@
+/* PROTOCOL: UART RECEIVE STREAMING FUNCTIONS: start, read, timestamps, status, stop */
+
+/* include the necessary libraries */
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "dwf.h"
+#include "../device.h"
+#include "../tools.h"
+#include "../ring.h"
+
+#ifndef WF_PROTOCOL_UART_STREAM
+#define WF_PROTOCOL_UART_STREAM
+namespace wf {
+
+class UART_Stream {
+    public:
+        class Chunk {
+            /* bytes received by one poll */
+            public:
+                long long time = 0;             // timestamp of the poll, see tools.timestamp
+                unsigned long long first = 0;   // position of the first byte in the stream
+                int count = 0;
+        };
+
+        class Data {
+            public:
+                unsigned long long bytes = 0;           // received bytes
+                unsigned long long dropped_bytes = 0;   // bytes lost because the ring was full
+                unsigned long long overflows = 0;       // receive buffer overflows reported by the device
+                unsigned long long parity_errors = 0;   // chunks with a parity error
+                unsigned long long polls = 0;
+                long long last_time = 0;                // timestamp of the last received chunk
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        bytes = data.bytes;
+                        dropped_bytes = data.dropped_bytes;
+                        overflows = data.overflows;
+                        parity_errors = data.parity_errors;
+                        polls = data.polls;
+                        last_time = data.last_time;
+                    }
+                    return *this;
+                }
+        };
+
+    private:
+        Ring<unsigned char> bytes;
+        Ring<Chunk> chunks;
+        std::vector<char> buffer;           // receive buffer of the poller, allocated in start
+        std::thread poller;
+        std::mutex lock;
+        std::condition_variable arrived;
+        std::atomic<bool> running{false};
+        std::atomic<bool> failed{false};
+        std::atomic<unsigned long long> received{0};
+        std::atomic<unsigned long long> overflows{0};
+        std::atomic<unsigned long long> parity_errors{0};
+        std::atomic<unsigned long long> polls{0};
+        std::atomic<long long> last_time{0};
+        Error error;
+        HDWF handle = 0;
+        Device::Data *owner = nullptr;
+        std::chrono::nanoseconds interval{0};
+        void poll(void);
+
+    public:
+        Data data;
+        void start(Device::Data *device_data, int ring_size = 1 << 20, double interval = 0.0005);
+        int read(Device::Data *device_data, unsigned char *data, int size, double timeout = 0);
+        std::vector<unsigned char> read(Device::Data *device_data, int size, double timeout = 0);
+        std::vector<Chunk> timestamps(int max_count = 0);
+        Data status(void);
+        void stop(Device::Data *device_data);
+        ~UART_Stream() {
+            stop(nullptr);
+        }
+} uart_stream;
+
+}
+#endif
@@ -0,0 +1,212 @@
+/* SIGNAL QUALITY FUNCTIONS: measure */
+
+/* include the header */
+#include "quality.h"
+
+/* ----------------------------------------------------- */
+
+wf::Quality::Data wf::Quality::measure(const double *samples, int length, double sample_rate, DwfWindow window, int harmonics) {
+    /*
+        measure the distortion and noise of a sine wave
+
+        parameters: - samples - the signal
+                    - length - number of samples
+                    - sample rate of the signal in Hz
+                    - window type, use tools.window, default is Blackman-Harris
+                    - harmonics - number of harmonics counted as distortion, the fundamental included, default is 6
+
+        returns:    - fundamental frequency and amplitude, noise, THD, SNR, SINAD, SFDR, ENOB,
+                      the frequency of the largest spur and the level of every harmonic,
+                      harmonics below the noise are NaN and set the noise_limited flag
+
+        the powers are summed over the main lobes of the window and divided by its noise bandwidth,
+        the noise inside the lobes of the fundamental and the harmonics is estimated from the other bins,
+        the side lobes of the window limit the measurable range (about 90dB with Blackman-Harris),
+        use coherent sampling and the rectangular window above it
+    */
+    Data data;
+    int bins = length / 2 + 1;
+    int width = lobe(window);
+    if (length < 4 * width + 4 || sample_rate <= 0) {
+        return data;
+    }
+
+    // windowed transform, the buffers are kept for the next call
+    std::shared_ptr<const std::vector<double>> coefficients = fft.window(window, length);
+    const double *weights = coefficients->data();
+    thread_local std::vector<double> segment;
+    thread_local std::vector<std::complex<double>> spectrum;
+    thread_local std::vector<double> power;
+    thread_local std::vector<char> used;
+    segment.resize(length);
+    spectrum.resize(bins);
+    power.resize(bins);
+    used.assign(bins, 0);
+    double bandwidth = 0;
+    for (int index = 0; index < length; index++) {
+        segment[index] = samples[index] * weights[index];
+        bandwidth += weights[index] * weights[index];
+    }
+    // noise bandwidth of the window in bins, the coefficients have an average of 1
+    bandwidth /= length;
+    fft.real(segment.data(), length, spectrum.data());
+
+    // mean square value of a tone in every bin
+    for (int index = 0; index < bins; index++) {
+        double scale = (index == 0 || 2 * index == length) ? 1.0 / length : 2.0 / length;
+        power[index] = std::norm(spectrum[index]) * scale * scale / 2;
+    }
+
+    // the offset is removed
+    int lobe_bins = 0;
+    integrate(power.data(), bins, 0, width, used, lobe_bins);
+
+    // find the fundamental and interpolate its frequency with the center of mass of its lobe
+    int peak = width + 1;
+    for (int index = width + 1; index < bins; index++) {
+        if (power[index] > power[peak]) {
+            peak = index;
+        }
+    }
+    double offset = 0, sum = 0;
+    for (int index = peak - width + 1; index < peak + width && index < bins; index++) {
+        offset += (index - peak) * power[index];
+        sum += power[index];
+    }
+    offset = sum > 0 ? offset / sum : 0;
+    data.frequency = (peak + offset) * sample_rate / length;
+    double signal = integrate(power.data(), bins, peak, width, used, lobe_bins);
+    int signal_bins = lobe_bins;
+
+    // harmonics, folded back into the first Nyquist zone
+    std::vector<double> harmonic_power;
+    std::vector<int> harmonic_bins;
+    for (int order = 2; order <= harmonics; order++) {
+        double position = std::fmod(order * (peak + offset), double(length));
+        if (position > length / 2.0) {
+            position = length - position;
+        }
+        harmonic_power.push_back(integrate(power.data(), bins, int(position + 0.5), width, used, lobe_bins));
+        harmonic_bins.push_back(lobe_bins);
+    }
+
+    // the largest spur is searched before the noise bins are known
+    int spur = -1;
+    for (int index = 0; index < bins; index++) {
+        if (!used[index] && (spur < 0 || power[index] > power[spur])) {
+            spur = index;
+        }
+    }
+
+    // noise: the average of the free bins is extended to the whole band, without the offset
+    double noise = 0;
+    int noise_bins = 0;
+    for (int index = 0; index < bins; index++) {
+        if (!used[index]) {
+            noise += power[index];
+            noise_bins++;
+        }
+    }
+    double noise_density = noise_bins > 0 ? noise / noise_bins : 0;
+    int band = bins - (width + 1 < bins ? width + 1 : bins);
+    double noise_total = noise_density * band / bandwidth;
+    signal = (signal - noise_density * signal_bins) / bandwidth;
+    signal = signal > 0 ? signal : 0;
+
+    // distortion, without the noise in the lobes of the harmonics
+    double distortion = 0;
+    for (size_t index = 0; index < harmonic_power.size(); index++) {
+        double value = (harmonic_power[index] - noise_density * harmonic_bins[index]) / bandwidth;
+        if (value > 0) {
+            distortion += value;
+            data.harmonics.push_back(10.0 * log10(value / signal));
+        }
+        else {
+            // buried in the noise, the level can't be measured
+            data.harmonics.push_back(NAN);
+            data.noise_limited = true;
+        }
+    }
+
+    // the largest spur is the largest harmonic lobe or the largest free lobe
+    double spur_power = 0;
+    if (spur >= 0) {
+        spur_power = integrate(power.data(), bins, spur, width, used, lobe_bins) / bandwidth;
+        data.spur_frequency = spur * sample_rate / length;
+    }
+    for (size_t index = 0; index < harmonic_power.size(); index++) {
+        double value = harmonic_power[index] / bandwidth;
+        if (value > spur_power) {
+            spur_power = value;
+            double position = std::fmod((index + 2) * data.frequency, sample_rate);
+            data.spur_frequency = position > sample_rate / 2 ? sample_rate - position : position;
+        }
+    }
+
+    // metrics
+    data.amplitude = sqrt(2 * signal);
+    data.noise = sqrt(noise_total);
+    data.thd = distortion > 0 ? 10.0 * log10(distortion / signal) : NAN;
+    data.snr = 10.0 * log10(signal / noise_total);
+    data.sinad = 10.0 * log10(signal / (noise_total + distortion));
+    data.sfdr = 10.0 * log10(signal / spur_power);
+    data.enob = (data.sinad - 1.76) / 6.02;
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Quality::Data wf::Quality::measure(const std::vector<double> &samples, double sample_rate, DwfWindow window, int harmonics) {
+    /*
+        measure the distortion and noise of a sine wave
+
+        parameters: - samples - the signal
+                    - sample rate of the signal in Hz
+                    - window type, use tools.window, default is Blackman-Harris
+                    - harmonics - number of harmonics counted as distortion, the fundamental included, default is 6
+
+        returns:    - fundamental frequency and amplitude, noise, THD, SNR, SINAD, SFDR, ENOB,
+                      the frequency of the largest spur and the level of every harmonic,
+                      harmonics below the noise are NaN and set the noise_limited flag
+    */
+    return measure(samples.data(), int(samples.size()), sample_rate, window, harmonics);
+}
+
+/* ----------------------------------------------------- */
+
+int wf::Quality::lobe(DwfWindow window) {
+    /*
+        half width of the main lobe of a window in bins, with one bin of margin for tones between the bins
+    */
+    if (window == DwfWindowRectangular) {
+        return 2;
+    }
+    else if (window == DwfWindowBlackman) {
+        return 4;
+    }
+    else if (window == DwfWindowBlackmanHarris) {
+        return 5;
+    }
+    else if (window == DwfWindowFlatTop) {
+        return 6;
+    }
+    return 3;
+}
+
+/* ----------------------------------------------------- */
+
+double wf::Quality::integrate(const double *power, int bins, int center, int width, std::vector<char> &used, int &count) {
+    /*
+        sum the bins of a lobe which aren't part of another lobe, and mark them
+    */
+    double sum = 0;
+    count = 0;
+    for (int index = center - width; index <= center + width; index++) {
+        if (index >= 0 && index < bins && !used[index]) {
+            sum += power[index];
+            used[index] = 1;
+            count++;
+        }
+    }
+    return sum;
+}
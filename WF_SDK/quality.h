@@ -0,0 +1,58 @@
+/* SIGNAL QUALITY FUNCTIONS: measure */
+
+/* include the necessary libraries */
+#include <vector>
+#include <complex>
+#include <memory>
+#include <cmath>
+#include "dwf.h"
+#include "fft.h"
+
+#ifndef WF_QUALITY
+#define WF_QUALITY
+namespace wf {
+
+class Quality {
+    public:
+        class Data {
+            public:
+                double frequency = 0;               // fundamental frequency in Hz, interpolated between the bins
+                double amplitude = 0;               // fundamental amplitude in V
+                double noise = 0;                   // RMS noise in V, without the harmonics
+                double thd = 0;                     // total harmonic distortion in dBc
+                double snr = 0;                     // signal to noise ratio in dB
+                double sinad = 0;                   // signal to noise and distortion ratio in dB
+                double sfdr = 0;                    // spurious free dynamic range in dBc
+                double enob = 0;                    // effective number of bits
+                double spur_frequency = 0;          // frequency of the largest spur in Hz
+                std::vector<double> harmonics;      // level of the 2nd, 3rd, ... harmonics in dBc, NaN if below the noise
+                bool noise_limited = false;         // a harmonic is below the noise, THD is a lower bound (NaN if every one is)
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        frequency = data.frequency;
+                        amplitude = data.amplitude;
+                        noise = data.noise;
+                        thd = data.thd;
+                        snr = data.snr;
+                        sinad = data.sinad;
+                        sfdr = data.sfdr;
+                        enob = data.enob;
+                        spur_frequency = data.spur_frequency;
+                        harmonics = data.harmonics;
+                        noise_limited = data.noise_limited;
+                    }
+                    return *this;
+                }
+        };
+
+    private:
+        int lobe(DwfWindow window);
+        double integrate(const double *power, int bins, int center, int width, std::vector<char> &used, int &count);
+
+    public:
+        Data measure(const double *samples, int length, double sample_rate, DwfWindow window = DwfWindowBlackmanHarris, int harmonics = 6);
+        Data measure(const std::vector<double> &samples, double sample_rate, DwfWindow window = DwfWindowBlackmanHarris, int harmonics = 6);
+} quality;
+
+}
+#endif
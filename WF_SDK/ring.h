@@ -0,0 +1,149 @@
+/* RING BUFFER: single producer, single consumer lock-free queue used by the background threads */
+
+/* include the necessary libraries */
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+#ifndef WF_RING
+#define WF_RING
+namespace wf {
+
+template <typename T>
+class Ring {
+    private:
+        std::vector<T> buffer;
+        std::atomic<unsigned long long> head{0};
+        std::atomic<unsigned long long> tail{0};
+        std::atomic<unsigned long long> dropped{0};
+
+    public:
+        void resize(size_t size);
+        void clear(void);
+        size_t capacity(void) const;
+        size_t size(void) const;
+        unsigned long long drop_count(void) const;
+        bool push(const T &item);
+        size_t push(const T *items, size_t count);
+        bool pop(T &item);
+        size_t pop(T *items, size_t count);
+};
+
+/* ----------------------------------------------------- */
+
+template <typename T>
+void Ring<T>::resize(size_t size) {
+    /*
+        allocate the storage, not thread safe, call it before the threads start
+    */
+    buffer.assign(size, T());
+    clear();
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+template <typename T>
+void Ring<T>::clear(void) {
+    /*
+        drop every queued item, not thread safe
+    */
+    head = 0;
+    tail = 0;
+    dropped = 0;
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+template <typename T>
+size_t Ring<T>::capacity(void) const {
+    return buffer.size();
+}
+
+/* ----------------------------------------------------- */
+
+template <typename T>
+size_t Ring<T>::size(void) const {
+    return size_t(head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire));
+}
+
+/* ----------------------------------------------------- */
+
+template <typename T>
+unsigned long long Ring<T>::drop_count(void) const {
+    /*
+        returns:    - the number of items rejected because the queue was full
+    */
+    return dropped.load(std::memory_order_relaxed);
+}
+
+/* ----------------------------------------------------- */
+
+template <typename T>
+bool Ring<T>::push(const T &item) {
+    /*
+        producer side: queue one item
+
+        returns:    - False if the queue is full (the item is dropped)
+    */
+    return push(&item, 1) == 1;
+}
+
+/* ----------------------------------------------------- */
+
+template <typename T>
+size_t Ring<T>::push(const T *items, size_t count) {
+    /*
+        producer side: queue several items
+
+        returns:    - the number of queued items, the rest is dropped
+    */
+    unsigned long long current_head = head.load(std::memory_order_relaxed);
+    unsigned long long current_tail = tail.load(std::memory_order_acquire);
+    size_t space = buffer.size() - size_t(current_head - current_tail);
+    size_t accepted = count < space ? count : space;
+    for (size_t index = 0; index < accepted; index++) {
+        buffer[(current_head + index) % buffer.size()] = items[index];
+    }
+    head.store(current_head + accepted, std::memory_order_release);
+    if (accepted < count) {
+        dropped.fetch_add(count - accepted, std::memory_order_relaxed);
+    }
+    return accepted;
+}
+
+/* ----------------------------------------------------- */
+
+template <typename T>
+bool Ring<T>::pop(T &item) {
+    /*
+        consumer side: take the oldest item
+
+        returns:    - False if the queue is empty
+    */
+    return pop(&item, 1) == 1;
+}
+
+/* ----------------------------------------------------- */
+
+template <typename T>
+size_t Ring<T>::pop(T *items, size_t count) {
+    /*
+        consumer side: take the oldest items
+
+        returns:    - the number of items copied
+    */
+    unsigned long long current_tail = tail.load(std::memory_order_relaxed);
+    unsigned long long current_head = head.load(std::memory_order_acquire);
+    size_t available = size_t(current_head - current_tail);
+    size_t taken = count < available ? count : available;
+    for (size_t index = 0; index < taken; index++) {
+        items[index] = buffer[(current_tail + index) % buffer.size()];
+    }
+    tail.store(current_tail + taken, std::memory_order_release);
+    return taken;
+}
+
+}
+#endif
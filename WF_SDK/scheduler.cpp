@@ -0,0 +1,188 @@
+/* SCHEDULER FUNCTIONS: every, after, cancel, run, stop, status */
+
+/* include the header */
+#include "scheduler.h"
+
+/* ----------------------------------------------------- */
+
+int wf::Scheduler::every(double period, std::function<void(void)> task, double delay) {
+    /*
+        register a periodic task
+
+        parameters: - period in seconds
+                    - task
+                    - delay of the first run in seconds, default is 0
+
+        returns:    - task id, used to cancel the task
+    */
+    return add(delay, period, task);
+}
+
+/* ----------------------------------------------------- */
+
+int wf::Scheduler::after(double delay, std::function<void(void)> task) {
+    /*
+        register a task which runs once
+
+        parameters: - delay in seconds
+                    - task
+
+        returns:    - task id, used to cancel the task
+    */
+    return add(delay, 0, task);
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Scheduler::cancel(int id) {
+    /*
+        remove a task, it can be called from a running task
+
+        parameters: - task id
+    */
+    if (id == current) {
+        current_cancelled = true;
+    }
+    for (size_t index = 0; index < queue.size(); index++) {
+        if (queue[index].id == id) {
+            queue.erase(queue.begin() + index);
+            std::make_heap(queue.begin(), queue.end(), Later());
+            break;
+        }
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Scheduler::run(double duration) {
+    /*
+        run the registered tasks in the calling thread, sleeping between them
+
+        parameters: - duration in seconds, 0 means until stop() is called or no task is left
+
+        periodic tasks keep their rate: the next deadline is counted from the previous one,
+        periods which were missed completely are skipped
+    */
+    running = true;
+    clock::time_point end = clock::time_point::max();
+    if (duration > 0) {
+        end = clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(duration));
+    }
+
+    while (running && !queue.empty()) {
+        // take the earliest task
+        if (queue.front().deadline > end) {
+            wait_until(end);
+            break;
+        }
+        std::pop_heap(queue.begin(), queue.end(), Later());
+        Task task = queue.back();
+        queue.pop_back();
+
+        // wait for the deadline, a stop() meanwhile keeps the task for the next run
+        if (!wait_until(task.deadline)) {
+            queue.push_back(task);
+            std::push_heap(queue.begin(), queue.end(), Later());
+            break;
+        }
+        clock::time_point now = clock::now();
+        double lateness = std::chrono::duration<double>(now - task.deadline).count();
+        if (lateness > statistics.max_lateness) {
+            statistics.max_lateness = lateness;
+        }
+        statistics.runs++;
+
+        // execute it
+        current = task.id;
+        current_cancelled = false;
+        try {
+            task.function();
+        }
+        catch (...) {
+            current = 0;
+            running = false;
+            throw;
+        }
+        current = 0;
+
+        // schedule the next run of periodic tasks
+        if (task.period > clock::duration::zero() && !current_cancelled) {
+            task.deadline += task.period;
+            now = clock::now();
+            if (task.deadline <= now) {
+                long long missed = (now - task.deadline) / task.period + 1;
+                task.deadline += task.period * missed;
+                statistics.missed_periods += missed;
+            }
+            queue.push_back(task);
+            std::push_heap(queue.begin(), queue.end(), Later());
+        }
+    }
+    running = false;
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Scheduler::stop(void) {
+    /*
+        stop run() after the current task, it can be called from a task or from another thread,
+        a run() waiting for the next deadline returns immediately
+    */
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        running = false;
+    }
+    wake.notify_all();
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Scheduler::Data wf::Scheduler::status(void) {
+    /*
+        return the number of tasks and the timing statistics
+
+        returns:    - tasks, runs, missed periods, maximum lateness in seconds
+    */
+    statistics.tasks = int(queue.size());
+    return statistics;
+}
+
+/* ----------------------------------------------------- */
+
+int wf::Scheduler::add(double delay, double period, std::function<void(void)> task) {
+    /*
+        register a task with its first deadline
+    */
+    Task item;
+    item.id = ++last_id;
+    item.deadline = clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(delay));
+    item.period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(period));
+    item.function = task;
+    queue.push_back(item);
+    std::push_heap(queue.begin(), queue.end(), Later());
+    return item.id;
+}
+
+/* ----------------------------------------------------- */
+
+bool wf::Scheduler::wait_until(clock::time_point deadline) {
+    /*
+        sleep until a deadline like tools.sleep_until, but stop() wakes the sleeper
+
+        returns:    - False if the scheduler was stopped meanwhile
+    */
+    const std::chrono::microseconds spin(200);
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        wake.wait_until(guard, deadline - spin, [this]() {
+            return !running;
+        });
+    }
+    while (running && clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    return running;
+}
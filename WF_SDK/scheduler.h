@@ -0,0 +1,80 @@
+/* SCHEDULER FUNCTIONS: every, after, cancel, run, stop, status */
+
+/* include the necessary libraries */
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "dwf.h"
+#include "device.h"
+#include "tools.h"
+
+#ifndef WF_SCHEDULER
+#define WF_SCHEDULER
+namespace wf {
+
+class Scheduler {
+    public:
+        class Data {
+            public:
+                int tasks = 0;
+                unsigned long long runs = 0;
+                unsigned long long missed_periods = 0;
+                double max_lateness = 0;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        tasks = data.tasks;
+                        runs = data.runs;
+                        missed_periods = data.missed_periods;
+                        max_lateness = data.max_lateness;
+                    }
+                    return *this;
+                }
+        };
+
+    private:
+        typedef std::chrono::steady_clock clock;
+
+        class Task {
+            /* a registered task and its next deadline */
+            public:
+                int id = 0;
+                clock::time_point deadline;
+                clock::duration period = clock::duration::zero();
+                std::function<void(void)> function;
+        };
+
+        class Later {
+            /* orders the heap by the earliest deadline */
+            public:
+                bool operator()(const Task &first, const Task &second) const {
+                    return first.deadline > second.deadline;
+                }
+        };
+
+        std::vector<Task> queue;
+        std::atomic<bool> running{false};
+        std::mutex lock;
+        std::condition_variable wake;
+        int last_id = 0;
+        int current = 0;
+        bool current_cancelled = false;
+        Data statistics;
+        int add(double delay, double period, std::function<void(void)> task);
+        bool wait_until(clock::time_point deadline);
+
+    public:
+        int every(double period, std::function<void(void)> task, double delay = 0);
+        int after(double delay, std::function<void(void)> task);
+        void cancel(int id);
+        void run(double duration = 0);
+        void stop(void);
+        Data status(void);
+} scheduler;
+
+}
+#endif
@@ -15,6 +15,9 @@ void wf::Scope::open(Device::Data *device_data, double sampling_frequency, int b
                     - offset voltage in Volts, default is 0V
                     - amplitude range in Volts, default is ±5V
     */
+    // get the analog input information, if it isn't known yet
+    device.get_info(device_data, device.info.analog_input);
+
     // set global variables
     data.sampling_frequency = sampling_frequency;
     data.max_buffer_size = device_data->analog.input.max_buffer_size;
@@ -159,8 +162,50 @@ std::vector<double> wf::Scope::record(Device::Data *device_data, int channel) {
                     - the selected oscilloscope channel (1-2, or 1-4)
 
         returns:    - buffer - a list with the recorded voltages
+                      (data.start_time is the timestamp of the first sample, see tools.timestamp)
+    */
+    acquire(device_data);
+
+    // copy buffer
+    std::vector<double> buffer(data.buffer_size);  // try to create an empty buffer
+    if (FDwfAnalogInStatusData(device_data->handle, channel - 1, buffer.data(), data.buffer_size) == 0) {
+        device.check_error(device_data);
+    }
+    return buffer;
+}
+
+/* ----------------------------------------------------- */
+
+std::vector<std::vector<double>> wf::Scope::record(Device::Data *device_data, const std::vector<int> &channels) {
+    /*
+        record analog signals on several channels in the same acquisition, so their samples are simultaneous
+
+        parameters: - device handle
+                    - the selected oscilloscope channels (1-2, or 1-4)
+
+        returns:    - buffers - a list with the recorded voltages for every channel, in the order of the channels
+                      (data.start_time is the timestamp of the first sample, see tools.timestamp)
+    */
+    acquire(device_data);
+
+    // copy the buffers
+    std::vector<std::vector<double>> buffers(channels.size(), std::vector<double>(data.buffer_size));
+    for (size_t index = 0; index < channels.size(); index++) {
+        if (FDwfAnalogInStatusData(device_data->handle, channels[index] - 1, buffers[index].data(), data.buffer_size) == 0) {
+            device.check_error(device_data);
+        }
+    }
+    return buffers;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Scope::acquire(Device::Data *device_data) {
+    /*
+        start an acquisition, wait until it is done and stamp it
     */
     // set up the instrument
+    long long start = tools.timestamp();
     if (FDwfAnalogInConfigure(device_data->handle, false, true) == 0) {
         device.check_error(device_data);
     }
@@ -178,13 +223,9 @@ std::vector<double> wf::Scope::record(Device::Data *device_data, int channel) {
             break;
         }
     }
-    
-    // copy buffer
-    std::vector<double> buffer(data.buffer_size);  // try to create an empty buffer
-    if (FDwfAnalogInStatusData(device_data->handle, channel - 1, buffer.data(), data.buffer_size) == 0) {
-        device.check_error(device_data);
-    }
-    return buffer;
+
+    data.start_time = tools.acquisition_start(start, data.buffer_size, data.sampling_frequency);
+    return;
 }
 
 /* ----------------------------------------------------- */
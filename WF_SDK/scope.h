@@ -4,6 +4,7 @@
 #include <vector>
 #include "dwf.h"
 #include "device.h"
+#include "tools.h"
 
 #ifndef WF_SCOPE
 #define WF_SCOPE
@@ -25,16 +26,20 @@ class Scope {
                 int sampling_frequency = 20e06;
                 int buffer_size = 0;
                 int max_buffer_size = 0;
+                long long start_time = 0;
                 Data& operator=(const Data &data) {
                     if (this != &data) {
                         sampling_frequency = data.sampling_frequency;
                         buffer_size = data.buffer_size;
                         max_buffer_size = data.max_buffer_size;
+                        start_time = data.start_time;
                     }
                     return *this;
                 }
         };
 
+        void acquire(Device::Data *device_data);
+
     public:
         Trigger_Source trigger_source;
         Data data;
@@ -42,6 +47,7 @@ class Scope {
         double measure(Device::Data *device_data, int channel);
         void trigger(Device::Data *device_data, bool enable, const TRIGSRC source = trigsrcNone, int channel = 1, double timeout = 0, bool edge_rising = true, double level = 0);
         std::vector<double> record(Device::Data *device_data, int channel);
+        std::vector<std::vector<double>> record(Device::Data *device_data, const std::vector<int> &channels);
         void close(Device::Data *device_data);
 } scope;
 
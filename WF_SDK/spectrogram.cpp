@@ -0,0 +1,187 @@
+/* SPECTROGRAM FUNCTIONS: shape, compute, save */
+
+/* include the header */
+#include "spectrogram.h"
+
+/* ----------------------------------------------------- */
+
+wf::Spectrogram::Data wf::Spectrogram::shape(long long count, double sample_rate, int frame_length, double overlap) {
+    /*
+        get the size of a spectrogram, use it to allocate the output buffer
+
+        parameters: - count - number of samples in the recording
+                    - sample rate of the recording in Hz
+                    - frame_length - samples in one transform, sets the resolution, default is 1024
+                    - overlap - overlap of the frames between 0 and 0.95, default is 0.5
+
+        returns:    - frames (rows), bins (columns), hop, resolution and frame time
+    */
+    Data data;
+    data.sample_rate = sample_rate;
+    data.frame_length = frame_length < 2 ? 2 : frame_length;
+    overlap = overlap < 0 ? 0 : (overlap > 0.95 ? 0.95 : overlap);
+    int hop = int(data.frame_length * (1 - overlap) + 0.5);
+    data.hop = hop < 1 ? 1 : hop;
+    data.frames = count >= data.frame_length ? (count - data.frame_length) / data.hop + 1 : 0;
+    data.bins = data.frame_length / 2 + 1;
+    data.resolution = sample_rate / data.frame_length;
+    data.frame_time = sample_rate > 0 ? data.hop / sample_rate : 0;
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Spectrogram::Data wf::Spectrogram::compute(const double *samples, long long count, double sample_rate, float *output, int frame_length, double overlap, DwfWindow window, int threads) {
+    /*
+        calculate the spectrogram of a recording
+
+        parameters: - samples - the recording
+                    - count - number of samples
+                    - sample rate of the recording in Hz
+                    - output - buffer of frames * bins values, allocated by the caller (see shape),
+                               filled row by row with the magnitudes of every frame in dBV
+                    - frame_length - samples in one transform, sets the resolution, default is 1024
+                    - overlap - overlap of the frames between 0 and 0.95, default is 0.5
+                    - window type, use tools.window, default is Hann
+                    - threads - number of threads, 0 means one per core
+
+        returns:    - frames (rows), bins (columns), hop, resolution and frame time
+    */
+    Data data = shape(count, sample_rate, frame_length, overlap);
+    run(samples, data, window, 0, data.frames, output, threads);
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Spectrogram::Data wf::Spectrogram::compute(const std::vector<double> &samples, double sample_rate, std::vector<float> &output, int frame_length, double overlap, DwfWindow window, int threads) {
+    /*
+        calculate the spectrogram of a recording
+
+        parameters: - samples - the recording
+                    - sample rate of the recording in Hz
+                    - output - resized to frames * bins values, filled row by row in dBV
+                    - frame_length - samples in one transform, sets the resolution, default is 1024
+                    - overlap - overlap of the frames between 0 and 0.95, default is 0.5
+                    - window type, use tools.window, default is Hann
+                    - threads - number of threads, 0 means one per core
+
+        returns:    - frames (rows), bins (columns), hop, resolution and frame time
+    */
+    Data data = shape((long long)samples.size(), sample_rate, frame_length, overlap);
+    output.resize((size_t)data.frames * data.bins);
+    run(samples.data(), data, window, 0, data.frames, output.data(), threads);
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Spectrogram::Data wf::Spectrogram::save(const double *samples, long long count, double sample_rate, const std::string &path, int frame_length, double overlap, DwfWindow window, int threads) {
+    /*
+        calculate the spectrogram of a recording and write it to a binary file,
+        the frames are computed in blocks, so the memory doesn't depend on the length of the recording
+
+        parameters: - samples - the recording
+                    - count - number of samples
+                    - sample rate of the recording in Hz
+                    - path of the file
+                    - frame_length - samples in one transform, sets the resolution, default is 1024
+                    - overlap - overlap of the frames between 0 and 0.95, default is 0.5
+                    - window type, use tools.window, default is Hann
+                    - threads - number of threads, 0 means one per core
+
+        returns:    - frames (rows), bins (columns), hop, resolution and frame time
+
+        file format (native byte order): "WF_SDK_SPECTROGRAM", int format version (1), double sample rate,
+                    int frame length, int hop, long long frames, int bins, then frames * bins floats in dBV, row by row
+    */
+    Data data = shape(count, sample_rate, frame_length, overlap);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (file.is_open()) {
+        const char magic[] = "WF_SDK_SPECTROGRAM";
+        int format = 1;
+        file.write(magic, sizeof(magic) - 1);
+        file.write((const char *)&format, sizeof(format));
+        file.write((const char *)&data.sample_rate, sizeof(data.sample_rate));
+        file.write((const char *)&data.frame_length, sizeof(data.frame_length));
+        file.write((const char *)&data.hop, sizeof(data.hop));
+        file.write((const char *)&data.frames, sizeof(data.frames));
+        file.write((const char *)&data.bins, sizeof(data.bins));
+
+        // compute and write the frames in blocks
+        long long block = 4096;
+        std::vector<float> buffer((size_t)(data.frames < block ? data.frames : block) * data.bins);
+        for (long long first = 0; first < data.frames && file.good(); first += block) {
+            long long rows = data.frames - first < block ? data.frames - first : block;
+            run(samples, data, window, first, rows, buffer.data(), threads);
+            file.write((const char *)buffer.data(), (std::streamsize)(rows * data.bins * sizeof(float)));
+        }
+    }
+    if (!file.good()) {
+        Error error;
+        error.instrument = "spectrogram";
+        error.function = "save";
+        error.message = "Can't write " + path;
+        throw error;
+    }
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Spectrogram::run(const double *samples, const Data &data, DwfWindow window, long long first, long long count, float *output, int threads) {
+    /*
+        transform a range of frames on a pool of threads, the threads take small blocks of frames
+        from a shared counter, so they stay busy until the end
+    */
+    if (count <= 0) {
+        return;
+    }
+    const long long block = 16;
+    std::shared_ptr<const std::vector<double>> coefficients = fft.window(window, data.frame_length);
+    std::atomic<long long> next(0);
+
+    auto work = [&]() {
+        // buffers of the thread
+        int length = data.frame_length;
+        std::vector<double> segment(length);
+        std::vector<std::complex<double>> bins(data.bins);
+        const double *weights = coefficients->data();
+
+        while (true) {
+            long long start = next.fetch_add(block);
+            if (start >= count) {
+                break;
+            }
+            long long stop = start + block < count ? start + block : count;
+            for (long long frame = start; frame < stop; frame++) {
+                const double *source = samples + (first + frame) * data.hop;
+                for (int index = 0; index < length; index++) {
+                    segment[index] = source[index] * weights[index];
+                }
+                fft.real(segment.data(), length, bins.data());
+
+                // magnitudes in dBV, scaled like tools.spectrum
+                float *row = output + frame * data.bins;
+                for (int bin = 0; bin < data.bins; bin++) {
+                    double scale = (bin == 0 || 2 * bin == length) ? 1.0 / length : 2.0 / length;
+                    row[bin] = float(10.0 * log10(std::norm(bins[bin]) * scale * scale / 2));
+                }
+            }
+        }
+    };
+
+    // start the pool, the calling thread is one of the workers
+    int thread_count = threads > 0 ? threads : int(std::thread::hardware_concurrency());
+    long long blocks = (count + block - 1) / block;
+    thread_count = thread_count < 1 ? 1 : (thread_count > blocks ? int(blocks) : thread_count);
+    std::vector<std::thread> pool;
+    for (int index = 1; index < thread_count; index++) {
+        pool.push_back(std::thread(work));
+    }
+    work();
+    for (size_t index = 0; index < pool.size(); index++) {
+        pool[index].join();
+    }
+    return;
+}
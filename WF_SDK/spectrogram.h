@@ -0,0 +1,55 @@
+/* SPECTROGRAM FUNCTIONS: shape, compute, save */
+
+/* include the necessary libraries */
+#include <vector>
+#include <complex>
+#include <string>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include "dwf.h"
+#include "device.h"         // needed for the errors
+#include "fft.h"
+
+#ifndef WF_SPECTROGRAM
+#define WF_SPECTROGRAM
+namespace wf {
+
+class Spectrogram {
+    public:
+        class Data {
+            public:
+                double sample_rate = 0;
+                int frame_length = 0;
+                int hop = 0;
+                long long frames = 0;               // rows of the result
+                int bins = 0;                       // columns of the result, from 0Hz to sample_rate / 2
+                double resolution = 0;              // bin spacing in Hz
+                double frame_time = 0;              // time between the starts of two frames in seconds
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        sample_rate = data.sample_rate;
+                        frame_length = data.frame_length;
+                        hop = data.hop;
+                        frames = data.frames;
+                        bins = data.bins;
+                        resolution = data.resolution;
+                        frame_time = data.frame_time;
+                    }
+                    return *this;
+                }
+        };
+
+    private:
+        void run(const double *samples, const Data &data, DwfWindow window, long long first, long long count, float *output, int threads);
+
+    public:
+        Data shape(long long count, double sample_rate, int frame_length = 1024, double overlap = 0.5);
+        Data compute(const double *samples, long long count, double sample_rate, float *output, int frame_length = 1024, double overlap = 0.5, DwfWindow window = DwfWindowHann, int threads = 0);
+        Data compute(const std::vector<double> &samples, double sample_rate, std::vector<float> &output, int frame_length = 1024, double overlap = 0.5, DwfWindow window = DwfWindowHann, int threads = 0);
+        Data save(const double *samples, long long count, double sample_rate, const std::string &path, int frame_length = 1024, double overlap = 0.5, DwfWindow window = DwfWindowHann, int threads = 0);
+} spectrogram;
+
+}
+#endif
@@ -1,4 +1,4 @@
-/* STATIC I/O CONTROL FUNCTIONS: set_mode, get_state, set_state, set_current, set_pull, close */
+/* STATIC I/O CONTROL FUNCTIONS: set_mode, set_modes, get_state, get_states, set_state, set_states, set_current, set_pull, close */
 
 /* include the header */
 #include "static.h"
@@ -16,27 +16,29 @@ void wf::Static::set_mode(Device::Data *device_data, int channel, bool output) {
     if (device_data->name == std::string("Digital Discovery")) {
         channel = channel - 24;
     }
+    set_modes(device_data, 1u << channel, output ? 1u << channel : 0);
+    return;
+}
 
-    // count the DIO channels
-    data.count = tools.min(device_data->digital.input.channel_count, device_data->digital.output.channel_count);
+/* ----------------------------------------------------- */
 
+void wf::Static::set_modes(Device::Data *device_data, unsigned int mask, unsigned int outputs) {
+    /*
+        set several DIO lines as inputs, or as outputs with one write
+
+        parameters: - device data
+                    - mask of the lines to change (bit 0 is DIO0, or DIO24 on the Digital Discovery)
+                    - bit set means output, bit cleared means input, for the lines in the mask
+    */
     // load current state of the output enable buffer
-    unsigned int mask = 0;
-    if (FDwfDigitalIOOutputEnableGet(device_data->handle, &mask) == 0) {
+    unsigned int current = 0;
+    if (FDwfDigitalIOOutputEnableGet(device_data->handle, &current) == 0) {
         device.check_error(device_data);
     }
-    
-    // set bit in mask
-    if (output == true) {
-        mask |= rotate_left(1, channel, data.count);
-    }
-    else {
-        unsigned int bits = (unsigned int)pow(2, data.count) - 2;
-        mask &= rotate_left(bits, channel, data.count);
-    }
-    
-    // set the pin to output
-    if (FDwfDigitalIOOutputEnableSet(device_data->handle, mask) == 0) {
+
+    // set the selected lines
+    current = (current & ~mask) | (outputs & mask);
+    if (FDwfDigitalIOOutputEnableSet(device_data->handle, current) == 0) {
         device.check_error(device_data);
     }
     return;
@@ -57,31 +59,38 @@ bool wf::Static::get_state(Device::Data *device_data, int channel) {
         channel = channel - 24;
     }
 
+    // check the required bit
+    return (get_states(device_data) & (1u << channel)) != 0;
+}
+
+/* ----------------------------------------------------- */
+
+unsigned int wf::Static::get_states(Device::Data *device_data) {
+    /*
+        get the state of every DIO line with one status read
+
+        parameters: - device data
+
+        returns:    - bit n is set if the line n is HIGH (bit 0 is DIO0, or DIO24 on the Digital Discovery)
+    */
     // load internal buffer with current state of the pins
     if (FDwfDigitalIOStatus(device_data->handle) == 0) {
         device.check_error(device_data);
     }
-    
+
     // get the current state of the pins
-    unsigned int data = 0;  // variable for this current state
-    if (FDwfDigitalIOInputStatus(device_data->handle, &data) == 0) {
+    unsigned int states = 0;
+    if (FDwfDigitalIOInputStatus(device_data->handle, &states) == 0) {
         device.check_error(device_data);
     }
-    
-    // check the required bit
-    if (data & (1 << channel) != 0) {
-        return true;
-    }
-    else {
-        return false;
-    }
+    return states;
 }
 
 /* ----------------------------------------------------- */
 
 void wf::Static::set_state(Device::Data *device_data, int channel, bool value) {
     /*
-        set a DIO line as input, or as output
+        set the state of a DIO line
 
         parameters: - device data
                     - selected DIO channel number
@@ -90,27 +99,29 @@ void wf::Static::set_state(Device::Data *device_data, int channel, bool value) {
     if (device_data->name == std::string("Digital Discovery")) {
         channel = channel - 24;
     }
+    set_states(device_data, 1u << channel, value ? 1u << channel : 0);
+    return;
+}
 
-    // count the DIO channels
-    data.count = tools.min(device_data->digital.input.channel_count, device_data->digital.output.channel_count);
+/* ----------------------------------------------------- */
 
+void wf::Static::set_states(Device::Data *device_data, unsigned int mask, unsigned int values) {
+    /*
+        set the state of several DIO lines with one write
+
+        parameters: - device data
+                    - mask of the lines to change (bit 0 is DIO0, or DIO24 on the Digital Discovery)
+                    - bit set means HIGH, bit cleared means LOW, for the lines in the mask
+    */
     // load current state of the output state buffer
-    unsigned int mask = 0;
-    if (FDwfDigitalIOOutputGet(device_data->handle, &mask) == 0) {
+    unsigned int current = 0;
+    if (FDwfDigitalIOOutputGet(device_data->handle, &current) == 0) {
         device.check_error(device_data);
     }
-    
-    // set bit in mask
-    if (value == true) {
-        mask |= rotate_left(1, channel, data.count);
-    }
-    else {
-        unsigned int bits = (unsigned int)pow(2, data.count) - 2;
-        mask &= rotate_left(bits, channel, data.count);
-    }
-    
-    // set the pin state
-    if (FDwfDigitalIOOutputSet(device_data->handle, mask) == 0) {
+
+    // set the selected lines
+    current = (current & ~mask) | (values & mask);
+    if (FDwfDigitalIOOutputSet(device_data->handle, current) == 0) {
         device.check_error(device_data);
     }
     return;
@@ -125,23 +136,10 @@ void wf::Static::set_current(Device::Data *device_data, double current) {
         parameters: - device data
                     - current limit in mA: possible values are 2, 4, 6, 8, 12 and 16mA
     */
-    // search for the digital voltage channel
-    for (int channel_index = 0; channel_index < device_data->analog.IO.channel_count; channel_index++) {
-        if (device_data->analog.IO.channel_label[channel_index] == std::string("VDD")) {
-            data.channel = channel_index;
-            break;
-        }
-    }
-
-    // search for the drive node
-    if (data.channel >= 0) {
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[data.channel]; node_index++) {
-            if (device_data->analog.IO.node_name[data.channel][node_index] == std::string("Drive")) {
-                data.nodes.current = node_index;
-                break;
-            }
-        }
-    }
+    // the drive node is resolved with the analog IO information
+    device.get_info(device_data, device.info.analog_IO);
+    data.channel = device_data->analog.IO.index.dio_drive.channel;
+    data.nodes.current = device_data->analog.IO.index.dio_drive.node;
 
     // set limit
     if (data.channel >= 0 && data.nodes.current >= 0) {
@@ -167,46 +165,16 @@ void wf::Static::set_pull(Device::Data *device_data, int channel, double directi
         channel = channel - 24;
     }
     
+    // the pull nodes are resolved with the analog IO information
+    device.get_info(device_data, device.info.analog_IO | device.info.digital_input | device.info.digital_output);
+
     // count the DIO channels
     data.count = tools.min(device_data->digital.input.channel_count, device_data->digital.output.channel_count);
 
-    // search for the digital voltage channel
-    for (int channel_index = 0; channel_index < device_data->analog.IO.channel_count; channel_index++) {
-        if (device_data->analog.IO.channel_label[channel_index] == std::string("VDD")) {
-            data.channel = channel_index;
-            break;
-        }
-    }
-    
-    // search for the pull enable node
-    if (data.channel >= 0) {
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[data.channel]; node_index++) {
-            if (device_data->analog.IO.node_name[data.channel][node_index] == std::string("DIOPE")) {
-                data.nodes.pull_enable = node_index;
-                break;
-            }
-        }
-    }
-
-    // search for the pull direction node
-    if (data.channel >= 0) {
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[data.channel]; node_index++) {
-            if (device_data->analog.IO.node_name[data.channel][node_index] == std::string("DIOPP")) {
-                data.nodes.pull_direction = node_index;
-                break;
-            }
-        }
-    }
-
-    // search for the weak pull node
-    if (data.channel >= 0) {
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[data.channel]; node_index++) {
-            if (device_data->analog.IO.node_name[data.channel][node_index] == std::string("DINPP")) {
-                data.nodes.pull_weak = node_index;
-                break;
-            }
-        }
-    }
+    data.channel = device_data->analog.IO.index.dio_pull_enable.channel;
+    data.nodes.pull_enable = device_data->analog.IO.index.dio_pull_enable.node;
+    data.nodes.pull_direction = device_data->analog.IO.index.dio_pull_direction.node;
+    data.nodes.pull_weak = device_data->analog.IO.index.dio_pull_weak.node;
 
     // set pull enable mask
     double mask = 0;
@@ -1,4 +1,4 @@
-/* STATIC I/O CONTROL FUNCTIONS: set_mode, get_state, set_state, set_current, set_pull, close */
+/* STATIC I/O CONTROL FUNCTIONS: set_mode, set_modes, get_state, get_states, set_state, set_states, set_current, set_pull, close */
 
 /* include the necessary libraries */
 #include <algorithm>
@@ -57,8 +57,11 @@ class Static {
         Data data;
         Pull pull;
         void set_mode(Device::Data *device_data, int channel, bool output);
+        void set_modes(Device::Data *device_data, unsigned int mask, unsigned int outputs);
         bool get_state(Device::Data *device_data, int channel);
+        unsigned int get_states(Device::Data *device_data);
         void set_state(Device::Data *device_data, int channel, bool value);
+        void set_states(Device::Data *device_data, unsigned int mask, unsigned int values);
         void set_current(Device::Data *device_data, double current);
         void set_pull(Device::Data *device_data, int channel, double dirtection);
         void close(Device::Data *device_data);
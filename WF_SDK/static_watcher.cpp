@@ -0,0 +1,163 @@
+/* STATIC I/O EDGE WATCHER FUNCTIONS: start, read, status, stop */
+
+/* include the header */
+#include "static_watcher.h"
+#include <chrono>
+
+/* ----------------------------------------------------- */
+
+void wf::Static_Watcher::start(Device::Data *device_data, double rate, unsigned int mask, int queue_size) {
+    /*
+        start polling the DIO lines on a background thread
+
+        parameters: - device data
+                    - rate - polling frequency in Hz, default is 10KHz
+                    - mask - lines to watch (bit 0 is DIO0, or DIO24 on the Digital Discovery), default is all
+                    - queue_size - maximum number of events waiting to be read, default is 65536
+    */
+    stop(device_data);
+    handle = device_data->handle;
+    this->mask = mask;
+    data.rate = rate;
+    events.resize(queue_size);
+    polls = 0;
+    missed_intervals = 0;
+    max_interval = 0;
+    elapsed = 0;
+    failed = false;
+    running = true;
+    watcher = std::thread(&Static_Watcher::watch, this);
+
+    // device.close stops the watcher before the handle is closed
+    owner = device_data;
+    owner->engines[this] = [this]() {
+        stop(nullptr);
+    };
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+std::vector<wf::Static_Watcher::Event> wf::Static_Watcher::read(Device::Data *device_data, int max_count) {
+    /*
+        take the queued events
+
+        parameters: - device data
+                    - max_count - maximum number of events, default is 0 (every queued event)
+
+        returns:    - list of events: time (steady clock nanoseconds), mask of changed lines, state of the lines
+    */
+    if (failed) {
+        device_data->error = error;
+        throw device_data->error;
+    }
+    size_t count = events.size();
+    if (max_count > 0 && size_t(max_count) < count) {
+        count = max_count;
+    }
+    std::vector<Event> result(count);
+    result.resize(events.pop(result.data(), count));
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Static_Watcher::Data wf::Static_Watcher::status(void) {
+    /*
+        returns:    - the polling statistics: achieved rate (Hz), number of polls,
+                      missed polling intervals, dropped events, longest interval between polls (s)
+    */
+    data.polls = polls;
+    data.missed_intervals = missed_intervals;
+    data.dropped_events = events.drop_count();
+    data.max_interval = max_interval * 1e-09;
+    data.achieved_rate = elapsed > 0 ? polls * 1e09 / elapsed : 0;
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Static_Watcher::stop(Device::Data*) {
+    /*
+        stop the watcher thread
+    */
+    running = false;
+    if (watcher.joinable()) {
+        watcher.join();
+    }
+    if (owner != nullptr) {
+        owner->engines.erase(this);
+        owner = nullptr;
+    }
+    status();
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Static_Watcher::watch(void) {
+    /*
+        watcher thread: poll the lines and queue the changes
+    */
+    typedef std::chrono::steady_clock clock;
+    std::chrono::nanoseconds period((long long)(1e09 / data.rate));
+    clock::time_point start = clock::now();
+    clock::time_point next = start;
+    clock::time_point previous = start;
+    unsigned int last = 0;
+    bool first = true;
+
+    while (running) {
+        // read every line at once
+        unsigned int value = 0;
+        if (FDwfDigitalIOStatus(handle) == 0 || FDwfDigitalIOInputStatus(handle, &value) == 0) {
+            char message[512];
+            FDwfGetLastErrorMsg(message);
+            error.instrument = "static_watcher";
+            error.function = "watch";
+            error.message = message;
+            failed = true;
+            break;
+        }
+        clock::time_point now = clock::now();
+
+        // queue the changes
+        unsigned int changed = (value ^ last) & mask;
+        if (!first && changed != 0) {
+            Event event;
+            event.time = tools.timestamp();
+            event.changed = changed;
+            event.value = value;
+            events.push(event);
+        }
+        last = value;
+
+        // update statistics
+        long long interval = std::chrono::duration_cast<std::chrono::nanoseconds>(now - previous).count();
+        if (!first && interval > max_interval) {
+            max_interval = interval;
+        }
+        previous = now;
+        first = false;
+        polls++;
+        elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+
+        // schedule the next poll, skip the intervals which are already lost
+        next += period;
+        if (now > next + period) {
+            missed_intervals += (now - next) / period;
+            next = now;
+        }
+
+        // sleep most of the time, spin only for the last part of the interval
+        while ((now = clock::now()) < next && running) {
+            if (next - now > std::chrono::microseconds(1000)) {
+                std::this_thread::sleep_for(next - now - std::chrono::microseconds(500));
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    return;
+}
@@ -0,0 +1,74 @@
+/* STATIC I/O EDGE WATCHER FUNCTIONS: start, read, status, stop */
+
+/* include the necessary libraries */
+#include <vector>
+#include <atomic>
+#include <thread>
+#include "dwf.h"
+#include "device.h"
+#include "tools.h"
+#include "ring.h"
+
+#ifndef WF_STATIC_WATCHER
+#define WF_STATIC_WATCHER
+namespace wf {
+
+class Static_Watcher {
+    private:
+        class Data {
+            public:
+                double rate = 0;
+                double achieved_rate = 0;
+                unsigned long long polls = 0;
+                unsigned long long missed_intervals = 0;
+                unsigned long long dropped_events = 0;
+                double max_interval = 0;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        rate = data.rate;
+                        achieved_rate = data.achieved_rate;
+                        polls = data.polls;
+                        missed_intervals = data.missed_intervals;
+                        dropped_events = data.dropped_events;
+                        max_interval = data.max_interval;
+                    }
+                    return *this;
+                }
+        };
+
+    public:
+        class Event {
+            public:
+                long long time = 0;
+                unsigned int changed = 0;
+                unsigned int value = 0;
+        };
+
+    private:
+        Ring<Event> events;
+        std::thread watcher;
+        std::atomic<bool> running{false};
+        std::atomic<bool> failed{false};
+        std::atomic<unsigned long long> polls{0};
+        std::atomic<unsigned long long> missed_intervals{0};
+        std::atomic<long long> max_interval{0};
+        std::atomic<long long> elapsed{0};
+        Error error;
+        HDWF handle = 0;
+        Device::Data *owner = nullptr;
+        unsigned int mask = 0;
+        void watch(void);
+
+    public:
+        Data data;
+        void start(Device::Data *device_data, double rate = 10e03, unsigned int mask = 0xFFFFFFFF, int queue_size = 1 << 16);
+        std::vector<Event> read(Device::Data *device_data, int max_count = 0);
+        Data status(void);
+        void stop(Device::Data *device_data);
+        ~Static_Watcher() {
+            stop(nullptr);
+        }
+} static_watcher;
+
+}
+#endif
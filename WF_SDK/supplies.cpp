@@ -16,162 +16,25 @@ void wf::Supplies::switch_(Device::Data *device_data, Data supplies_data) {
                         - voltage and/or positive_voltage and negative_voltage
                         - current and/or positive_current and negative_current
     */
-    
-    //find the positive supply
-    int channel = -1;
-    for (int channel_index = 0; channel_index < device_data->analog.IO.channel_count; channel_index++) {
-        if (device_data->analog.IO.channel_label[channel_index] == std::string("V+") || device_data->analog.IO.channel_label[channel_index] == std::string("p25V")) {
-            channel = channel_index;
-            break;
-        }
-    }
-    if (channel != -1) {
-        // find and set enable node
-        int node = -1;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel]; node_index++) {
-            if (device_data->analog.IO.node_name[channel][node_index] == std::string("Enable")) {
-                node = node_index;
-                break;
-            }
-        }
-        if (node != -1) {
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, channel, node, supplies_data.positive_state) == 0) {
-                device.check_error(device_data);
-            }
-        }
-        // find and set voltage node
-        node = -1;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel]; node_index++) {
-            if (device_data->analog.IO.node_name[channel][node_index] == std::string("Voltage")) {
-                node = node_index;
-                break;
-            }
-        }
-        if (node != -1) {
-            double voltage = tools.min(tools.max(supplies_data.positive_voltage, device_data->analog.IO.min_set_range[channel][node]), device_data->analog.IO.max_set_range[channel][node]);
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, channel, node, voltage) == 0) {
-                device.check_error(device_data);
-            }
-        }
-        // find and set current node
-        node = -1;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel]; node_index++) {
-            if (device_data->analog.IO.node_name[channel][node_index] == std::string("Current")) {
-                node = node_index;
-                break;
-            }
-        }
-        if (node != -1) {
-            double current = tools.min(tools.max(supplies_data.positive_current, device_data->analog.IO.min_set_range[channel][node]), device_data->analog.IO.max_set_range[channel][node]);
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, channel, node, current) == 0) {
-                device.check_error(device_data);
-            }
-        }
-    }
 
-    //find the negative supply
-    channel = -1;
-    for (int channel_index = 0; channel_index < device_data->analog.IO.channel_count; channel_index++) {
-        if (device_data->analog.IO.channel_label[channel_index] == std::string("V-") || device_data->analog.IO.channel_label[channel_index] == std::string("n25V")) {
-            channel = channel_index;
-            break;
-        }
-    }
-    if (channel != -1) {
-        // find and set enable node
-        int node = -1;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel]; node_index++) {
-            if (device_data->analog.IO.node_name[channel][node_index] == std::string("Enable")) {
-                node = node_index;
-                break;
-            }
-        }
-        if (node != -1) {
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, channel, node, supplies_data.negative_state) == 0) {
-                device.check_error(device_data);
-            }
-        }
-        // find and set voltage node
-        node = -1;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel]; node_index++) {
-            if (device_data->analog.IO.node_name[channel][node_index] == std::string("Voltage")) {
-                node = node_index;
-                break;
-            }
-        }
-        if (node != -1) {
-            double voltage = tools.min(tools.max(supplies_data.negative_voltage, device_data->analog.IO.min_set_range[channel][node]), device_data->analog.IO.max_set_range[channel][node]);
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, channel, node, voltage) == 0) {
-                device.check_error(device_data);
-            }
-        }
-        // find and set current node
-        node = -1;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel]; node_index++) {
-            if (device_data->analog.IO.node_name[channel][node_index] == std::string("Current")) {
-                node = node_index;
-                break;
-            }
-        }
-        if (node != -1) {
-            double current = tools.min(tools.max(supplies_data.negative_current, device_data->analog.IO.min_set_range[channel][node]), device_data->analog.IO.max_set_range[channel][node]);
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, channel, node, current) == 0) {
-                device.check_error(device_data);
-            }
-        }
-    }
+    // the supply nodes are resolved with the analog IO information
+    device.get_info(device_data, device.info.analog_IO);
+    auto &index = device_data->analog.IO.index;
 
-    //find the digital/6V supply
-    channel = -1;
-    for (int channel_index = 0; channel_index < device_data->analog.IO.channel_count; channel_index++) {
-        if (device_data->analog.IO.channel_label[channel_index] == std::string("VDD") || device_data->analog.IO.channel_label[channel_index] == std::string("p6V")) {
-            channel = channel_index;
-            break;
-        }
-    }
-    if (channel != -1) {
-        // find and set enable node
-        int node = -1;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel]; node_index++) {
-            if (device_data->analog.IO.node_name[channel][node_index] == std::string("Enable")) {
-                node = node_index;
-                break;
-            }
-        }
-        if (node != -1) {
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, channel, node, supplies_data.state) == 0) {
-                device.check_error(device_data);
-            }
-        }
-        // find and set voltage node
-        node = -1;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel]; node_index++) {
-            if (device_data->analog.IO.node_name[channel][node_index] == std::string("Voltage")) {
-                node = node_index;
-                break;
-            }
-        }
-        if (node != -1) {
-            double voltage = tools.min(tools.max(supplies_data.voltage, device_data->analog.IO.min_set_range[channel][node]), device_data->analog.IO.max_set_range[channel][node]);
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, channel, node, voltage) == 0) {
-                device.check_error(device_data);
-            }
-        }
-        // find and set current node
-        node = -1;
-        for (int node_index = 0; node_index < device_data->analog.IO.node_count[channel]; node_index++) {
-            if (device_data->analog.IO.node_name[channel][node_index] == std::string("Current")) {
-                node = node_index;
-                break;
-            }
-        }
-        if (node != -1) {
-            double current = tools.min(tools.max(supplies_data.current, device_data->analog.IO.min_set_range[channel][node]), device_data->analog.IO.max_set_range[channel][node]);
-            if (FDwfAnalogIOChannelNodeSet(device_data->handle, channel, node, current) == 0) {
-                device.check_error(device_data);
-            }
-        }
-    }
+    // set the positive supply
+    set_node(device_data, index.positive_enable.channel, index.positive_enable.node, supplies_data.positive_state, false);
+    set_node(device_data, index.positive_voltage.channel, index.positive_voltage.node, supplies_data.positive_voltage);
+    set_node(device_data, index.positive_current.channel, index.positive_current.node, supplies_data.positive_current);
+
+    // set the negative supply
+    set_node(device_data, index.negative_enable.channel, index.negative_enable.node, supplies_data.negative_state, false);
+    set_node(device_data, index.negative_voltage.channel, index.negative_voltage.node, supplies_data.negative_voltage);
+    set_node(device_data, index.negative_current.channel, index.negative_current.node, supplies_data.negative_current);
+
+    // set the digital/6V supply
+    set_node(device_data, index.digital_enable.channel, index.digital_enable.node, supplies_data.state, false);
+    set_node(device_data, index.digital_voltage.channel, index.digital_voltage.node, supplies_data.voltage);
+    set_node(device_data, index.digital_current.channel, index.digital_current.node, supplies_data.current);
 
     // turn all supplies on/off
     if (FDwfAnalogIOEnableSet(device_data->handle, supplies_data.master_state) == 0) {
@@ -189,5 +52,31 @@ void wf::Supplies::close(Device::Data *device_data) {
     if (FDwfAnalogIOReset(device_data->handle) == 0) {
         device.check_error(device_data);
     }
+    // the reset also clears the DMM settings, the cached ones are dropped
+    device_data->analog_IO_generation++;
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Supplies::set_node(Device::Data *device_data, int channel, int node, double value, bool limit) {
+    /*
+        set an analog IO node, if it exists
+
+        parameters: - device data
+                    - channel index, -1 if missing
+                    - node index, -1 if missing
+                    - value
+                    - limit the value to the node range, default is True
+    */
+    if (channel < 0 || node < 0) {
+        return;
+    }
+    if (limit) {
+        value = tools.min(tools.max(value, device_data->analog.IO.min_set_range[channel][node]), device_data->analog.IO.max_set_range[channel][node]);
+    }
+    if (FDwfAnalogIOChannelNodeSet(device_data->handle, channel, node, value) == 0) {
+        device.check_error(device_data);
+    }
     return;
 }
@@ -12,6 +12,9 @@
 namespace wf {
 
 class Supplies {
+    private:
+        void set_node(Device::Data *device_data, int channel, int node, double value, bool limit = true);
+
     public:
         class Data {
             public:
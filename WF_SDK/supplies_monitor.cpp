@@ -0,0 +1,173 @@
+/* POWER SUPPLIES TELEMETRY FUNCTIONS: start, read, status, stop */
+
+/* include the header */
+#include "supplies_monitor.h"
+#include <chrono>
+
+/* ----------------------------------------------------- */
+
+void wf::Supplies_Monitor::start(Device::Data *device_data, double rate, int history_size) {
+    /*
+        start sampling the supply readback nodes on a background thread
+
+        parameters: - device data
+                    - rate - sampling frequency in Hz, default is 100Hz
+                    - history_size - number of samples kept until read, default is 16384
+    */
+    stop(device_data);
+    device.get_info(device_data, device.info.analog_IO);
+    handle = device_data->handle;
+
+    // collect the readable nodes of the supply channels
+    channels.clear();
+    nodes.clear();
+    statistics = Data();
+    statistics.rate = rate;
+    auto &index = device_data->analog.IO.index;
+    int supply_channels[3] = {index.positive_enable.channel, index.negative_enable.channel, index.digital_enable.channel};
+    for (int supply = 0; supply < 3; supply++) {
+        int channel = supply_channels[supply];
+        if (channel < 0) {
+            continue;
+        }
+        for (int node = 0; node < device_data->analog.IO.node_count[channel] && int(nodes.size()) < max_nodes; node++) {
+            if (device_data->analog.IO.max_read_range[channel][node] <= device_data->analog.IO.min_read_range[channel][node]) {
+                continue;   // not a readback node
+            }
+            channels.push_back(channel);
+            nodes.push_back(node);
+            statistics.names.push_back(device_data->analog.IO.channel_label[channel] + " " + device_data->analog.IO.node_name[channel][node]);
+            statistics.units.push_back(device_data->analog.IO.node_unit[channel][node]);
+        }
+    }
+    statistics.last.assign(nodes.size(), 0);
+    statistics.min.assign(nodes.size(), 0);
+    statistics.max.assign(nodes.size(), 0);
+    statistics.mean.assign(nodes.size(), 0);
+    data = statistics;
+
+    history.resize(history_size);
+    failed = false;
+    running = true;
+    sampler = std::thread(&Supplies_Monitor::sample, this);
+
+    // device.close stops the sampler before the handle is closed
+    owner = device_data;
+    owner->engines[this] = [this]() {
+        stop(nullptr);
+    };
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+std::vector<wf::Supplies_Monitor::Sample> wf::Supplies_Monitor::read(Device::Data *device_data, int max_count) {
+    /*
+        take the stored samples
+
+        parameters: - device data
+                    - max_count - maximum number of samples, default is 0 (every stored sample)
+
+        returns:    - list of samples: time (steady clock nanoseconds), value count, values in the order of data.names
+    */
+    if (failed) {
+        device_data->error = error;
+        throw device_data->error;
+    }
+    size_t count = history.size();
+    if (max_count > 0 && size_t(max_count) < count) {
+        count = max_count;
+    }
+    std::vector<Sample> result(count);
+    result.resize(history.pop(result.data(), count));
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Supplies_Monitor::Data wf::Supplies_Monitor::status(void) {
+    /*
+        returns:    - the node names and units, the last, minimum, maximum and mean values,
+                      the number of samples and the samples dropped because the history was full
+    */
+    std::lock_guard<std::mutex> guard(lock);
+    data = statistics;
+    data.dropped_samples = history.drop_count();
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Supplies_Monitor::stop(Device::Data*) {
+    /*
+        stop the sampler thread
+    */
+    running = false;
+    if (sampler.joinable()) {
+        sampler.join();
+    }
+    if (owner != nullptr) {
+        owner->engines.erase(this);
+        owner = nullptr;
+    }
+    status();
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Supplies_Monitor::sample(void) {
+    /*
+        sampler thread: read every node after one status call
+    */
+    typedef std::chrono::steady_clock clock;
+    std::chrono::nanoseconds period((long long)(1e09 / statistics.rate));
+    clock::time_point next = clock::now();
+    int count = int(nodes.size());
+
+    while (running) {
+        Sample current;
+        current.count = count;
+        bool success = FDwfAnalogIOStatus(handle) != 0;
+        for (int index = 0; index < count && success; index++) {
+            success = FDwfAnalogIOChannelNodeStatus(handle, channels[index], nodes[index], &current.values[index]) != 0;
+        }
+        if (!success) {
+            char message[512];
+            FDwfGetLastErrorMsg(message);
+            error.instrument = "supplies_monitor";
+            error.function = "sample";
+            error.message = message;
+            failed = true;
+            break;
+        }
+        current.time = tools.timestamp();
+        history.push(current);
+
+        // update the running statistics
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            statistics.samples++;
+            for (int index = 0; index < count; index++) {
+                double value = current.values[index];
+                statistics.last[index] = value;
+                if (statistics.samples == 1 || value < statistics.min[index]) {
+                    statistics.min[index] = value;
+                }
+                if (statistics.samples == 1 || value > statistics.max[index]) {
+                    statistics.max[index] = value;
+                }
+                statistics.mean[index] += (value - statistics.mean[index]) / statistics.samples;
+            }
+        }
+
+        // wait for the next tick
+        next += period;
+        clock::time_point now = clock::now();
+        if (now > next) {
+            next = now;
+        }
+        std::this_thread::sleep_until(next);
+    }
+    return;
+}
@@ -0,0 +1,82 @@
+/* POWER SUPPLIES TELEMETRY FUNCTIONS: start, read, status, stop */
+
+/* include the necessary libraries */
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include "dwf.h"
+#include "device.h"
+#include "tools.h"
+#include "ring.h"
+
+#ifndef WF_SUPPLIES_MONITOR
+#define WF_SUPPLIES_MONITOR
+namespace wf {
+
+class Supplies_Monitor {
+    public:
+        static const int max_nodes = 16;
+
+        class Sample {
+            public:
+                long long time = 0;
+                int count = 0;
+                double values[max_nodes];
+        };
+
+        class Data {
+            public:
+                double rate = 0;
+                unsigned long long samples = 0;
+                unsigned long long dropped_samples = 0;
+                std::vector<std::string> names;
+                std::vector<std::string> units;
+                std::vector<double> last;
+                std::vector<double> min;
+                std::vector<double> max;
+                std::vector<double> mean;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        rate = data.rate;
+                        samples = data.samples;
+                        dropped_samples = data.dropped_samples;
+                        names = data.names;
+                        units = data.units;
+                        last = data.last;
+                        min = data.min;
+                        max = data.max;
+                        mean = data.mean;
+                    }
+                    return *this;
+                }
+        };
+
+    private:
+        Ring<Sample> history;
+        std::thread sampler;
+        std::mutex lock;
+        std::atomic<bool> running{false};
+        std::atomic<bool> failed{false};
+        Error error;
+        HDWF handle = 0;
+        Device::Data *owner = nullptr;
+        std::vector<int> channels;
+        std::vector<int> nodes;
+        Data statistics;
+        void sample(void);
+
+    public:
+        Data data;
+        void start(Device::Data *device_data, double rate = 100, int history_size = 1 << 14);
+        std::vector<Sample> read(Device::Data *device_data, int max_count = 0);
+        Data status(void);
+        void stop(Device::Data *device_data);
+        ~Supplies_Monitor() {
+            stop(nullptr);
+        }
+} supplies_monitor;
+
+}
+#endif
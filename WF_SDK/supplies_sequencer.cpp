@@ -0,0 +1,272 @@
+/* POWER SUPPLIES SEQUENCER FUNCTIONS: ramp, run */
+
+/* include the header */
+#include "supplies_sequencer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+/* ----------------------------------------------------- */
+
+std::vector<wf::Supplies_Sequencer::Step> wf::Supplies_Sequencer::ramp(int rail, double start_time, double duration, double start_voltage, double stop_voltage, int count, double tolerance) {
+    /*
+        create the steps of a linear voltage ramp
+
+        parameters: - rail - possible: positive, negative, digital
+                    - start time in seconds, relative to the start of the sequence
+                    - duration of the ramp in seconds
+                    - start voltage in Volts
+                    - stop voltage in Volts
+                    - number of steps, default is 10
+                    - tolerance of the final voltage in Volts, default is 50mV
+
+        returns:    - list of steps, only the last one is verified
+    */
+    std::vector<Step> steps;
+    if (count < 1) {
+        count = 1;
+    }
+    for (int index = 0; index < count; index++) {
+        Step step;
+        double position = count > 1 ? double(index) / (count - 1) : 1.0;
+        step.time = start_time + duration * position;
+        step.rail = rail;
+        step.voltage = start_voltage + (stop_voltage - start_voltage) * position;
+        step.verify = index == count - 1;
+        step.tolerance = tolerance;
+        steps.push_back(step);
+    }
+    return steps;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Supplies_Sequencer::Data wf::Supplies_Sequencer::run(Device::Data *device_data, const std::vector<Step> &steps, double current_limit) {
+    /*
+        execute a list of supply setpoints on a fixed schedule
+
+        parameters: - device data
+                    - list of steps (executed in list order):
+                        - time in seconds, relative to the start of the sequence
+                        - rail - possible: positive, negative, digital
+                        - enable state
+                        - voltage in Volts, limited to the range of the rail, the readback is verified against the limited value
+                        - current limit in Amperes, 0 keeps the current setting
+                        - verify - wait for the voltage readback to settle
+                        - tolerance of the voltage readback in Volts
+                        - timeout of the verification in seconds
+                    - current_limit - the supplies are turned off if any rail draws more (in Amperes), 0 disables the check
+
+        returns:    - class containing the success flag, the failed step and the reason,
+                      the start jitter and the settling time of every executed step (s)
+
+        every rail is disabled before the master enable is set, so a rail starts only with its first step,
+        the supplies are turned off if the sequence fails or a device call throws
+    */
+    typedef std::chrono::steady_clock clock;
+    Data result;
+    Rail_Nodes rails[3];
+    resolve(device_data, rails);
+
+    try {
+        // disable every rail, then turn the supplies on, the rails start only with their steps
+        for (int index = 0; index < 3; index++) {
+            if (rails[index].channel >= 0 && rails[index].enable >= 0) {
+                if (FDwfAnalogIOChannelNodeSet(device_data->handle, rails[index].channel, rails[index].enable, 0) == 0) {
+                    device.check_error(device_data);
+                }
+            }
+        }
+        if (FDwfAnalogIOEnableSet(device_data->handle, true) == 0) {
+            device.check_error(device_data);
+        }
+
+        clock::time_point start = clock::now();
+        for (int index = 0; index < int(steps.size()); index++) {
+            const Step &step = steps[index];
+            bool overcurrent = false;
+            int failed_rail = -1;
+            double current = 0;
+
+            // wait for the step, watching the current meanwhile
+            clock::time_point deadline = start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(step.time));
+            wait_until(device_data, deadline, rails, current_limit, &overcurrent, &failed_rail, &current);
+            if (overcurrent) {
+                result.reason = "Overcurrent on rail " + std::to_string(failed_rail) + ": " + std::to_string(current) + "A";
+            }
+            else if (step.rail < 0 || step.rail > 2 || rails[step.rail].channel < 0) {
+                result.reason = "Rail " + std::to_string(step.rail) + " is not available";
+            }
+            if (result.reason != "") {
+                result.success = false;
+                result.failed_step = index;
+                break;
+            }
+
+            // apply the setpoint
+            double jitter = std::chrono::duration<double>(clock::now() - deadline).count();
+            result.jitter.push_back(jitter);
+            if (jitter > result.max_jitter) {
+                result.max_jitter = jitter;
+            }
+            Rail_Nodes &nodes = rails[step.rail];
+            auto &IO = device_data->analog.IO;
+            if (step.current > 0 && nodes.current >= 0 && IO.max_set_range[nodes.channel][nodes.current] > IO.min_set_range[nodes.channel][nodes.current]) {
+                double limit = std::min(std::max(step.current, IO.min_set_range[nodes.channel][nodes.current]), IO.max_set_range[nodes.channel][nodes.current]);
+                if (FDwfAnalogIOChannelNodeSet(device_data->handle, nodes.channel, nodes.current, limit) == 0) {
+                    device.check_error(device_data);
+                }
+            }
+            double target = step.voltage;   // the setpoint is limited to the range of the rail
+            if (nodes.voltage >= 0) {
+                target = std::min(std::max(step.voltage, IO.min_set_range[nodes.channel][nodes.voltage]), IO.max_set_range[nodes.channel][nodes.voltage]);
+                if (FDwfAnalogIOChannelNodeSet(device_data->handle, nodes.channel, nodes.voltage, target) == 0) {
+                    device.check_error(device_data);
+                }
+            }
+            if (nodes.enable >= 0) {
+                if (FDwfAnalogIOChannelNodeSet(device_data->handle, nodes.channel, nodes.enable, step.enable) == 0) {
+                    device.check_error(device_data);
+                }
+            }
+
+            // verify the readback
+            clock::time_point applied = clock::now();
+            double settle_time = 0;
+            if (step.verify && step.enable && nodes.voltage_readback) {
+                bool settled = false;
+                while (!settled) {
+                    if (check_current(device_data, rails, current_limit, &failed_rail, &current)) {
+                        overcurrent = true;
+                        break;
+                    }
+                    if (FDwfAnalogIOStatus(device_data->handle) == 0) {
+                        device.check_error(device_data);
+                    }
+                    double voltage = 0;
+                    if (FDwfAnalogIOChannelNodeStatus(device_data->handle, nodes.channel, nodes.voltage, &voltage) == 0) {
+                        device.check_error(device_data);
+                    }
+                    settle_time = std::chrono::duration<double>(clock::now() - applied).count();
+                    settled = std::fabs(voltage - target) <= step.tolerance;
+                    if (!settled && settle_time > step.timeout) {
+                        result.reason = "Rail " + std::to_string(step.rail) + " did not settle: " + std::to_string(voltage) + "V";
+                        break;
+                    }
+                }
+            }
+            result.settle_time.push_back(settle_time);
+            if (overcurrent) {
+                result.reason = "Overcurrent on rail " + std::to_string(failed_rail) + ": " + std::to_string(current) + "A";
+            }
+            if (result.reason != "") {
+                result.success = false;
+                result.failed_step = index;
+                break;
+            }
+        }
+    }
+    catch (...) {
+        // turn everything off if a call failed, then pass the error on
+        FDwfAnalogIOEnableSet(device_data->handle, false);
+        throw;
+    }
+
+    // turn everything off on failure
+    if (!result.success) {
+        if (FDwfAnalogIOEnableSet(device_data->handle, false) == 0) {
+            device.check_error(device_data);
+        }
+    }
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Supplies_Sequencer::resolve(Device::Data *device_data, Rail_Nodes *rails) {
+    /*
+        collect the nodes of every rail and check which ones can be read back
+    */
+    device.get_info(device_data, device.info.analog_IO);
+    auto &IO = device_data->analog.IO;
+    auto &index = IO.index;
+    rails[0].channel = index.positive_enable.channel;
+    rails[0].enable = index.positive_enable.node;
+    rails[0].voltage = index.positive_voltage.node;
+    rails[0].current = index.positive_current.node;
+    rails[1].channel = index.negative_enable.channel;
+    rails[1].enable = index.negative_enable.node;
+    rails[1].voltage = index.negative_voltage.node;
+    rails[1].current = index.negative_current.node;
+    rails[2].channel = index.digital_enable.channel;
+    rails[2].enable = index.digital_enable.node;
+    rails[2].voltage = index.digital_voltage.node;
+    rails[2].current = index.digital_current.node;
+    for (int rail = 0; rail < 3; rail++) {
+        int channel = rails[rail].channel;
+        if (channel < 0) {
+            continue;
+        }
+        if (rails[rail].voltage >= 0) {
+            rails[rail].voltage_readback = IO.max_read_range[channel][rails[rail].voltage] > IO.min_read_range[channel][rails[rail].voltage];
+        }
+        if (rails[rail].current >= 0) {
+            rails[rail].current_readback = IO.max_read_range[channel][rails[rail].current] > IO.min_read_range[channel][rails[rail].current];
+        }
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+bool wf::Supplies_Sequencer::check_current(Device::Data *device_data, Rail_Nodes *rails, double limit, int *rail, double *current) {
+    /*
+        read the current of every rail
+
+        returns:    - True if a rail draws more than the limit, the rail and the current are returned
+    */
+    if (limit <= 0) {
+        return false;
+    }
+    if (FDwfAnalogIOStatus(device_data->handle) == 0) {
+        device.check_error(device_data);
+    }
+    for (int index = 0; index < 3; index++) {
+        if (!rails[index].current_readback) {
+            continue;
+        }
+        double value = 0;
+        if (FDwfAnalogIOChannelNodeStatus(device_data->handle, rails[index].channel, rails[index].current, &value) == 0) {
+            device.check_error(device_data);
+        }
+        if (std::fabs(value) > limit) {
+            *rail = index;
+            *current = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Supplies_Sequencer::wait_until(Device::Data *device_data, std::chrono::steady_clock::time_point deadline, Rail_Nodes *rails, double limit, bool *overcurrent, int *rail, double *current) {
+    /*
+        wait for a deadline: monitor the current while there is time, then sleep with tools.sleep_until
+    */
+    typedef std::chrono::steady_clock clock;
+    const clock::duration guard = std::chrono::milliseconds(3);
+    while (clock::now() + guard < deadline) {
+        if (limit > 0) {
+            if (check_current(device_data, rails, limit, rail, current)) {
+                *overcurrent = true;
+                return;
+            }
+        }
+        else {
+            std::this_thread::sleep_until(deadline - guard);
+        }
+    }
+    tools.sleep_until(deadline);
+    return;
+}
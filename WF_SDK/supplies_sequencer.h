@@ -0,0 +1,80 @@
+/* POWER SUPPLIES SEQUENCER FUNCTIONS: ramp, run */
+
+/* include the necessary libraries */
+#include <vector>
+#include <string>
+#include <chrono>
+#include "dwf.h"
+#include "device.h"
+#include "tools.h"
+
+#ifndef WF_SUPPLIES_SEQUENCER
+#define WF_SUPPLIES_SEQUENCER
+namespace wf {
+
+class Supplies_Sequencer {
+    private:
+        class Rail {
+            /* supply rail names */
+            public:
+                const int positive = 0;
+                const int negative = 1;
+                const int digital = 2;
+        };
+
+        class Rail_Nodes {
+            /* resolved nodes of a rail */
+            public:
+                int channel = -1;
+                int enable = -1;
+                int voltage = -1;
+                int current = -1;
+                bool voltage_readback = false;
+                bool current_readback = false;
+        };
+
+        void resolve(Device::Data *device_data, Rail_Nodes *rails);
+        bool check_current(Device::Data *device_data, Rail_Nodes *rails, double limit, int *rail, double *current);
+        void wait_until(Device::Data *device_data, std::chrono::steady_clock::time_point deadline, Rail_Nodes *rails, double limit, bool *overcurrent, int *rail, double *current);
+
+    public:
+        class Step {
+            public:
+                double time = 0;
+                int rail = 0;
+                bool enable = true;
+                double voltage = 0;
+                double current = 0;
+                bool verify = true;
+                double tolerance = 0.05;
+                double timeout = 0.1;
+        };
+
+        class Data {
+            public:
+                bool success = true;
+                int failed_step = -1;
+                std::string reason = "";
+                std::vector<double> jitter;
+                std::vector<double> settle_time;
+                double max_jitter = 0;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        success = data.success;
+                        failed_step = data.failed_step;
+                        reason = data.reason;
+                        jitter = data.jitter;
+                        settle_time = data.settle_time;
+                        max_jitter = data.max_jitter;
+                    }
+                    return *this;
+                }
+        };
+
+        Rail rail;
+        std::vector<Step> ramp(int rail, double start_time, double duration, double start_voltage, double stop_voltage, int count = 10, double tolerance = 0.05);
+        Data run(Device::Data *device_data, const std::vector<Step> &steps, double current_limit = 0);
+} supplies_sequencer;
+
+}
+#endif
@@ -1,4 +1,4 @@
-/* TOOLS: sleep, keyboard_interrupt_reset */
+/* TOOLS: sleep, sleep_until, timestamp, acquisition_start, keyboard_interrupt_reset */
 
 /* include the header */
 #include "tools.h"
@@ -6,22 +6,71 @@
 /* ----------------------------------------------------- */
 
 void wf::Tools::sleep(int millis) {
-    int start = get_time();
-    int current = get_time();
-    while (current - start < millis) {
-        current = get_time();
+    /*
+        wait without loading the processor
+
+        parameters: - delay in milliseconds
+    */
+    sleep_until(std::chrono::steady_clock::now() + std::chrono::milliseconds(millis));
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Tools::sleep_until(std::chrono::steady_clock::time_point deadline) {
+    /*
+        wait until a moment, the thread sleeps and only the last part is spent polling the clock,
+        the clock is monotonic, so changes of the system time don't affect it
+
+        parameters: - deadline
+    */
+    const std::chrono::microseconds spin(200);
+    if (deadline - std::chrono::steady_clock::now() > spin) {
+        std::this_thread::sleep_until(deadline - spin);
+    }
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
     }
     return;
 }
 
 /* ----------------------------------------------------- */
 
-int wf::Tools::get_time(void) {
-    auto time = std::chrono::system_clock::now();
+long long wf::Tools::get_time(void) {
+    /*
+        returns:    - milliseconds of the monotonic clock from an arbitrary moment, use the difference of two values
+    */
+    auto time = std::chrono::steady_clock::now();
     auto duration = time.time_since_epoch();
     auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
-    int now = (int)millis.count();
-    return now;
+    return millis.count();
+}
+
+/* ----------------------------------------------------- */
+
+long long wf::Tools::timestamp(void) {
+    /*
+        returns:    - nanoseconds of the monotonic clock, the common time base of every stamped
+                      capture, reading and transfer, so they can be merged onto one timeline
+    */
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* ----------------------------------------------------- */
+
+long long wf::Tools::acquisition_start(long long start, int samples, double sampling_frequency) {
+    /*
+        estimate the timestamp of the first sample of an acquisition which was just reported as done
+
+        parameters: - start - timestamp taken before the acquisition was started
+                    - samples - number of recorded samples
+                    - sampling frequency in Hz
+
+        returns:    - timestamp of the first sample, the acquisition ended before it was reported,
+                      so the first sample was at most one record length earlier, but not before the start
+    */
+    long long length = (long long)(samples * 1e09 / sampling_frequency);
+    return max(start, timestamp() - length);
 }
 
 /* ----------------------------------------------------- */
@@ -68,25 +117,75 @@ inline T const& wf::Tools::max(T const& a, T const& b) {
 
 /* ----------------------------------------------------- */
 
-std::vector<double> wf::Tools::spectrum(std::vector<double> buffer, DwfWindow window, double sample_rate, double frequency_start, double frequency_stop) {
-    // get and apply window
-    int buffer_length = buffer.size();
-    std::vector<double> window_buffer(buffer_length);
-    FDwfSpectrumWindow(window_buffer.data(), buffer_length, window, 1.0, NULL);
-    for (int index = 0; index < buffer_length; index++) {
+std::vector<double> wf::Tools::spectrum(const std::vector<double> &buffer, DwfWindow window, double sample_rate, double frequency_start, double frequency_stop, int count) {
+    /*
+        calculate the spectrum of a signal
+
+        parameters: - buffer - the signal
+                    - window type, use tools.window
+                    - sample rate of the signal
+                    - frequency_start, frequency_stop - the displayed frequency range
+                    - count - number of bins, 0 means buffer.size() / 2 + 1
+
+        returns:    - count magnitudes in dBV, equally spaced between the start and stop frequencies
+    */
+    std::vector<double> windowed(buffer);
+    std::vector<double> result(count > 0 ? count : buffer.size() / 2 + 1);
+    spectrum(windowed.data(), int(windowed.size()), window, sample_rate, frequency_start, frequency_stop, result.data(), int(result.size()));
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Tools::spectrum(double *buffer, int length, DwfWindow window, double sample_rate, double frequency_start, double frequency_stop, double *spectrum, int count) {
+    /*
+        calculate the spectrum of a signal in place, without allocations for repeated sizes
+
+        parameters: - buffer - the signal, it is overwritten by the windowed signal
+                    - length - number of samples
+                    - window type, use tools.window
+                    - sample rate of the signal
+                    - frequency_start, frequency_stop - the displayed frequency range
+                    - spectrum - buffer for count magnitudes in dBV
+                    - count - number of bins, 0 means length / 2 + 1
+
+        a narrow range is computed with a chirp-z transform, so the bins can be much finer
+        than sample_rate / length without a longer transform
+    */
+    // apply the cached window
+    std::shared_ptr<const std::vector<double>> coefficients = fft.window(window, length);
+    const double *window_buffer = coefficients->data();
+    for (int index = 0; index < length; index++) {
         buffer[index] *= window_buffer[index];
     }
 
     // get the spectrum
-    int spectrum_length = buffer_length / 2 + 1;
-    std::vector<double> spectrum(spectrum_length);
-    frequency_start = max(frequency_start * 2.0 / sample_rate, 0.0);
-    frequency_stop = min(frequency_stop * 2.0 / sample_rate, 1.0);
-    FDwfSpectrumTransform(buffer.data(), buffer_length, spectrum.data(), NULL, spectrum_length, frequency_start, frequency_stop);
-    for (int index = 0; index < spectrum_length; index++) {
-        spectrum[index] = 20.0 * log10(spectrum[index] / sqrt(2));
+    int spectrum_length = length / 2 + 1;
+    count = count > 0 ? count : spectrum_length;
+    frequency_start = max(frequency_start / sample_rate, 0.0);
+    frequency_stop = min(frequency_stop / sample_rate, 0.5);
+    thread_local std::vector<std::complex<double>> bins;
+    double step = count > 1 ? (frequency_stop - frequency_start) / (count - 1) : 0;
+    if (frequency_start <= 0 && frequency_stop >= 0.5 && count == spectrum_length) {
+        // the whole band: native transform
+        bins.resize(spectrum_length);
+        fft.real(buffer, length, bins.data());
+        frequency_start = 0;
+        step = 1.0 / length;
+    }
+    else {
+        // a part of the band: chirp-z transform on the requested bins
+        bins.resize(count);
+        fft.zoom(buffer, length, frequency_start, step, count, bins.data());
     }
-    return spectrum;
+
+    // scale the bins to the amplitude of the tones, in dBV
+    for (int index = 0; index < count; index++) {
+        double frequency = frequency_start + index * step;
+        double scale = (frequency <= 0 || frequency >= 0.5) ? 1.0 / length : 2.0 / length;
+        spectrum[index] = 20.0 * log10(std::abs(bins[index]) * scale / sqrt(2));
+    }
+    return;
 }
 
 /* ----------------------------------------------------- */
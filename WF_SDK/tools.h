@@ -1,10 +1,12 @@
 #include <chrono>           // needed for sleep
+#include <thread>           // needed for sleep
 #include <time.h>           // needed for current time
 #include <signal.h>         // needed for keyboard interrupt
 #include <vector>           // needed for data list handling
 #include <cmath>            // needed for math functions
 #include "dwf.h"
 #include "device.h"         // needed for instrument control
+#include "fft.h"            // needed for the spectrum
 
 #ifndef WF_TOOLS
 #define WF_TOOLS
@@ -12,6 +14,7 @@ namespace wf {
 
 void ISR(int signum);
 int device_handle = 0;
+const double pi = 3.14159265358979323846;
 
 class Tools {
     private:
@@ -28,15 +31,19 @@ class Tools {
         };
     public:
         Window window;
-        int get_time(void);
+        long long get_time(void);
+        long long timestamp(void);
+        long long acquisition_start(long long start, int samples, double sampling_frequency);
         std::string get_date(void);
         void sleep(int millis);
+        void sleep_until(std::chrono::steady_clock::time_point deadline);
         void keyboard_interrupt_reset(Device::Data *device_data);
         template <typename T>
         inline T const& min(T const& a, T const& b);
         template <typename T>
         inline T const& max(T const& a, T const& b);
-        std::vector<double> spectrum(std::vector<double> buffer, DwfWindow window, double sample_rate, double frequency_start, double frequency_stop);
+        std::vector<double> spectrum(const std::vector<double> &buffer, DwfWindow window, double sample_rate, double frequency_start, double frequency_stop, int count = 0);
+        void spectrum(double *buffer, int length, DwfWindow window, double sample_rate, double frequency_start, double frequency_stop, double *spectrum, int count = 0);
 } tools;
 
 }
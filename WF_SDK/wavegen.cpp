@@ -1,4 +1,4 @@
-/* WAVEFORM GENERATOR CONTROL FUNCTIONS: generate, close */
+/* WAVEFORM GENERATOR CONTROL FUNCTIONS: generate, modulate, disable_modulation, set_frequency, set_amplitude, set_offset, close, enable, disable */
 
 /* include the header */
 #include "wavegen.h"
@@ -83,6 +83,144 @@ void wf::Wavegen::generate(Device::Data *device_data, int channel, FUNC function
 
 /* ----------------------------------------------------- */
 
+void wf::Wavegen::modulate(Device::Data *device_data, int channel, AnalogOutNode node, FUNC function, double frequency, double depth, double offset, double symmetry, std::vector<double> data) {
+    /*
+        set up hardware amplitude or frequency modulation of the carrier
+
+        parameters: - device data
+                    - the selected wavegen channel (1-2)
+                    - node - possible: AM, FM
+                    - function of the modulating signal - possible: custom, sine, square, triangle, noise, dc, pulse, trapezium, sine_power, ramp_up, ramp_down
+                    - frequency of the modulating signal in Hz
+                    - modulation depth in percentage: modulation index for AM, frequency deviation for FM, default is 50%
+                    - modulation offset in percentage, default is 0%
+                    - signal symmetry in percentage, default is 50%
+                    - data - list of samples between -1 and 1, used only if function=custom, default is empty
+
+        the modulation is applied on the next generate, or enable call
+    */
+    channel--;
+    int index = node_index(device_data, channel, node);
+
+    // enable the modulation node
+    if (FDwfAnalogOutNodeEnableSet(device_data->handle, channel, node, true) == 0) {
+        device.check_error(device_data);
+    }
+
+    // set function type
+    if (FDwfAnalogOutNodeFunctionSet(device_data->handle, channel, node, function) == 0) {
+        device.check_error(device_data);
+    }
+
+    // load data if the function type is custom
+    if (function == funcCustom) {
+        if (int(data.size()) > device_data->analog.output.max_buffer_size[channel][index]) {
+            data.resize(device_data->analog.output.max_buffer_size[channel][index]);
+        }
+        if (FDwfAnalogOutNodeDataSet(device_data->handle, channel, node, data.data(), data.size()) == 0) {
+            device.check_error(device_data);
+        }
+    }
+
+    // set modulation frequency
+    if (FDwfAnalogOutNodeFrequencySet(device_data->handle, channel, node, frequency) == 0) {
+        device.check_error(device_data);
+    }
+
+    // set modulation depth
+    if (FDwfAnalogOutNodeAmplitudeSet(device_data->handle, channel, node, depth) == 0) {
+        device.check_error(device_data);
+    }
+
+    // set modulation offset
+    if (FDwfAnalogOutNodeOffsetSet(device_data->handle, channel, node, offset) == 0) {
+        device.check_error(device_data);
+    }
+
+    // set symmetry
+    if (FDwfAnalogOutNodeSymmetrySet(device_data->handle, channel, node, symmetry) == 0) {
+        device.check_error(device_data);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Wavegen::disable_modulation(Device::Data *device_data, int channel, AnalogOutNode node) {
+    /*
+        turn off the modulation of the carrier
+
+        parameters: - device data
+                    - the selected wavegen channel (1-2)
+                    - node - possible: AM, FM
+    */
+    channel--;
+    node_index(device_data, channel, node);
+    if (FDwfAnalogOutNodeEnableSet(device_data->handle, channel, node, false) == 0) {
+        device.check_error(device_data);
+    }
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Wavegen::set_frequency(Device::Data *device_data, int channel, double frequency, AnalogOutNode node) {
+    /*
+        change the frequency of a running signal without restarting it
+
+        parameters: - device data
+                    - the selected wavegen channel (1-2)
+                    - frequency in Hz
+                    - node - possible: carrier, AM, FM, default is carrier
+    */
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (FDwfAnalogOutNodeFrequencySet(device_data->handle, channel - 1, node, frequency) == 0) {
+        device.check_error(device_data);
+    }
+    apply(device_data, channel - 1, start);
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Wavegen::set_amplitude(Device::Data *device_data, int channel, double amplitude, AnalogOutNode node) {
+    /*
+        change the amplitude of a running signal without restarting it
+
+        parameters: - device data
+                    - the selected wavegen channel (1-2)
+                    - amplitude in Volts (percentage for the AM and FM nodes)
+                    - node - possible: carrier, AM, FM, default is carrier
+    */
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (FDwfAnalogOutNodeAmplitudeSet(device_data->handle, channel - 1, node, amplitude) == 0) {
+        device.check_error(device_data);
+    }
+    apply(device_data, channel - 1, start);
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Wavegen::set_offset(Device::Data *device_data, int channel, double offset, AnalogOutNode node) {
+    /*
+        change the offset of a running signal without restarting it
+
+        parameters: - device data
+                    - the selected wavegen channel (1-2)
+                    - offset in Volts (percentage for the AM and FM nodes)
+                    - node - possible: carrier, AM, FM, default is carrier
+    */
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (FDwfAnalogOutNodeOffsetSet(device_data->handle, channel - 1, node, offset) == 0) {
+        device.check_error(device_data);
+    }
+    apply(device_data, channel - 1, start);
+    return;
+}
+
+/* ----------------------------------------------------- */
+
 void wf::Wavegen::close(Device::Data *device_data, int channel) {
     /*
         reset the wavegen
@@ -119,3 +257,66 @@ void wf::Wavegen::disable(Device::Data *device_data, int channel) {
     }
     return;
 }
+
+/* ----------------------------------------------------- */
+
+int wf::Wavegen::node_index(Device::Data *device_data, int channel, AnalogOutNode node, const char *caller) {
+    /*
+        find the position of a node in the device information lists
+
+        parameters: - device data
+                    - the selected wavegen channel (0-1)
+                    - node - possible: carrier, AM, FM
+                    - caller function name
+
+        returns:    - the node index, throws an error if the node is not available
+    */
+    device.get_info(device_data, device.info.analog_output);
+    std::string name = "carrier";
+    if (node == AnalogOutNodeFM) {
+        name = "FM";
+    }
+    else if (node == AnalogOutNodeAM) {
+        name = "AM";
+    }
+    if (channel >= 0 && channel < device_data->analog.output.channel_count) {
+        for (int index = 0; index < device_data->analog.output.node_count[channel]; index++) {
+            if (device_data->analog.output.node_type[channel][index] == name) {
+                return index;
+            }
+        }
+    }
+    device_data->error.instrument = "wavegen";
+    device_data->error.function = caller;
+    device_data->error.message = "The " + name + " node is not available on channel " + std::to_string(channel + 1);
+    throw device_data->error;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Wavegen::apply(Device::Data *device_data, int channel, std::chrono::steady_clock::time_point start) {
+    /*
+        apply the changed parameters to a running channel and update the latency statistics
+
+        parameters: - device data
+                    - the selected wavegen channel (0-1)
+                    - time when the update started
+    */
+    // 3 only applies the new settings, the channel is not restarted
+    if (FDwfAnalogOutConfigure(device_data->handle, channel, 3) == 0) {
+        device.check_error(device_data);
+    }
+
+    // update statistics (in seconds)
+    double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    data.last_latency = latency;
+    if (data.update_count == 0 || latency < data.min_latency) {
+        data.min_latency = latency;
+    }
+    if (latency > data.max_latency) {
+        data.max_latency = latency;
+    }
+    data.update_count++;
+    data.average_latency += (latency - data.average_latency) / data.update_count;
+    return;
+}
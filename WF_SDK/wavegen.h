@@ -1,7 +1,9 @@
-/* WAVEFORM GENERATOR CONTROL FUNCTIONS: generate, close, enable, disable */
+/* WAVEFORM GENERATOR CONTROL FUNCTIONS: generate, modulate, disable_modulation, set_frequency, set_amplitude, set_offset, close, enable, disable */
 
 /* include the necessary libraries */
 #include <vector>
+#include <string>
+#include <chrono>
 #include "dwf.h"
 #include "device.h"
 
@@ -27,9 +29,47 @@ class Wavegen {
                 const FUNC ramp_down = funcRampDown;
         };
 
+        class Node {
+            /* node names */
+            public:
+                const AnalogOutNode carrier = AnalogOutNodeCarrier;
+                const AnalogOutNode FM = AnalogOutNodeFM;
+                const AnalogOutNode AM = AnalogOutNodeAM;
+        };
+
+        class Data {
+            /* update latency statistics */
+            public:
+                int update_count = 0;
+                double last_latency = 0;
+                double min_latency = 0;
+                double max_latency = 0;
+                double average_latency = 0;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        update_count = data.update_count;
+                        last_latency = data.last_latency;
+                        min_latency = data.min_latency;
+                        max_latency = data.max_latency;
+                        average_latency = data.average_latency;
+                    }
+                    return *this;
+                }
+        };
+
+        void apply(Device::Data *device_data, int channel, std::chrono::steady_clock::time_point start);
+        int node_index(Device::Data *device_data, int channel, AnalogOutNode node, const char *caller = __builtin_FUNCTION());
+
     public:
         Function function;
+        Node node;
+        Data data;
         void generate(Device::Data *device_data, int channel, FUNC function, double offset, double frequency = 1e03, double amplitude = 1, double symmetry = 50, double wait = 0, double run_time = 0, int repeat = 0, std::vector<double> data = std::vector<double>());
+        void modulate(Device::Data *device_data, int channel, AnalogOutNode node, FUNC function, double frequency, double depth = 50, double offset = 0, double symmetry = 50, std::vector<double> data = std::vector<double>());
+        void disable_modulation(Device::Data *device_data, int channel, AnalogOutNode node);
+        void set_frequency(Device::Data *device_data, int channel, double frequency, AnalogOutNode node = AnalogOutNodeCarrier);
+        void set_amplitude(Device::Data *device_data, int channel, double amplitude, AnalogOutNode node = AnalogOutNodeCarrier);
+        void set_offset(Device::Data *device_data, int channel, double offset, AnalogOutNode node = AnalogOutNodeCarrier);
         void close(Device::Data *device_data, int channel = 0);
         void enable(Device::Data *device_data, int channel);
         void disable(Device::Data *device_data, int channel);
@@ -0,0 +1,265 @@
+/* WELCH SPECTRUM ANALYZER FUNCTIONS: open, push, spectrum, density, status, reset, close */
+
+/* include the header */
+#include "welch.h"
+
+/* ----------------------------------------------------- */
+
+void wf::Welch::open(double sample_rate, int segment_length, double overlap, DwfWindow window, int averages, int threads) {
+    /*
+        set up an averaged spectrum of a continuous signal
+
+        parameters: - sample rate of the signal in Hz
+                    - segment_length - samples in one transform, sets the resolution, default is 4096
+                    - overlap - overlap of the segments between 0 and 0.95, default is 0.5
+                    - window type, use tools.window, default is Hann
+                    - averages - 0 averages every segment equally, N averages exponentially over about
+                                 the last N segments, default is 0
+                    - threads - number of threads used for the transforms, 0 means one per core
+    */
+    std::lock_guard<std::mutex> guard(lock);
+    segment_length = segment_length < 2 ? 2 : segment_length;
+    overlap = overlap < 0 ? 0 : (overlap > 0.95 ? 0.95 : overlap);
+    int hop = int(segment_length * (1 - overlap) + 0.5);
+
+    data = Data();
+    data.sample_rate = sample_rate;
+    data.segment_length = segment_length;
+    data.hop = hop < 1 ? 1 : hop;
+    data.resolution = sample_rate / segment_length;
+    this->averages = averages < 0 ? 0 : averages;
+
+    // the window is normalized to an average of 1, its power sets the noise bandwidth of the bins
+    this->window = fft.window(window, segment_length);
+    double power = 0;
+    for (int index = 0; index < segment_length; index++) {
+        power += (*this->window)[index] * (*this->window)[index];
+    }
+    data.noise_bandwidth = sample_rate * power / (double(segment_length) * segment_length);
+
+    // every buffer is allocated here, the memory doesn't depend on the amount of pushed data
+    int bin_count = segment_length / 2 + 1;
+    thread_count = threads > 0 ? threads : int(std::thread::hardware_concurrency());
+    thread_count = thread_count < 1 ? 1 : thread_count;
+    workers.assign(thread_count, Worker());
+    for (int index = 0; index < thread_count; index++) {
+        workers[index].segment.resize(segment_length);
+        workers[index].bins.resize(bin_count);
+        workers[index].sum.resize(bin_count);
+    }
+    average.assign(bin_count, 0);
+    tail.clear();
+    tail.reserve(segment_length);
+    tail_start = 0;
+    next = 0;
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Welch::push(const double *samples, int count) {
+    /*
+        add the next chunk of the signal, every completed segment is transformed and averaged
+
+        parameters: - samples - the next samples of the signal, for example a scope record
+                    - count - number of samples
+    */
+    std::lock_guard<std::mutex> guard(lock);
+    if (workers.empty() || count <= 0) {
+        return;
+    }
+    int length = data.segment_length;
+    unsigned long long chunk_start = data.samples;
+    unsigned long long total = chunk_start + count;
+
+    // count the segments which end in this chunk
+    int segments = 0;
+    if (next + length <= total) {
+        segments = int((total - length - next) / data.hop) + 1;
+    }
+
+    if (segments > 0) {
+        // weight of every segment in the average: a running mean, or an exponential one after the first N segments
+        weights.resize(segments);
+        double decay = 1;
+        for (int index = segments - 1; index >= 0; index--) {
+            unsigned long long number = data.segments + index + 1;
+            if (averages > 0 && number > (unsigned long long)averages) {
+                number = averages;
+            }
+            double alpha = 1.0 / number;
+            weights[index] = alpha * decay;
+            decay *= 1 - alpha;
+        }
+
+        // split the segments between the threads, every thread sums into its own buffer
+        int used = thread_count < segments ? thread_count : segments;
+        std::vector<std::thread> threads;
+        int first = 0;
+        for (int index = 0; index < used; index++) {
+            int share = segments / used + (index < segments % used ? 1 : 0);
+            Worker &worker = workers[index];
+            std::fill(worker.sum.begin(), worker.sum.end(), 0.0);
+            unsigned long long start = next + (unsigned long long)first * data.hop;
+            const double *weight = weights.data() + first;
+            if (index == used - 1) {
+                process(worker, samples, chunk_start, start, share, weight);
+            }
+            else {
+                threads.push_back(std::thread(&Welch::process, this, std::ref(worker), samples, chunk_start, start, share, weight));
+            }
+            first += share;
+        }
+        for (size_t index = 0; index < threads.size(); index++) {
+            threads[index].join();
+        }
+
+        // update the average
+        for (size_t bin = 0; bin < average.size(); bin++) {
+            double sum = 0;
+            for (int index = 0; index < used; index++) {
+                sum += workers[index].sum[bin];
+            }
+            average[bin] = average[bin] * decay + sum;
+        }
+        data.segments += segments;
+        next += (unsigned long long)segments * data.hop;
+    }
+    data.samples = total;
+
+    // keep the samples of the unfinished segment
+    if (next < chunk_start) {
+        tail.erase(tail.begin(), tail.begin() + (next - tail_start));
+        tail.insert(tail.end(), samples, samples + count);
+    }
+    else if (next < total) {
+        tail.assign(samples + (next - chunk_start), samples + count);
+    }
+    else {
+        tail.clear();
+    }
+    tail_start = next;
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Welch::push(const std::vector<double> &samples) {
+    /*
+        add the next chunk of the signal
+
+        parameters: - samples - the next samples of the signal, for example a scope record
+    */
+    push(samples.data(), int(samples.size()));
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+std::vector<double> wf::Welch::spectrum(void) {
+    /*
+        get the averaged spectrum
+
+        returns:    - segment_length / 2 + 1 magnitudes in dBV from 0Hz to sample_rate / 2,
+                      on the same scale as tools.spectrum, empty before the first segment
+    */
+    std::lock_guard<std::mutex> guard(lock);
+    std::vector<double> result;
+    if (data.segments > 0) {
+        result.resize(average.size());
+        for (size_t index = 0; index < average.size(); index++) {
+            result[index] = 10.0 * log10(average[index] / 2);
+        }
+    }
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+std::vector<double> wf::Welch::density(void) {
+    /*
+        get the averaged power spectral density
+
+        returns:    - segment_length / 2 + 1 values in V^2/Hz from 0Hz to sample_rate / 2,
+                      empty before the first segment
+    */
+    std::lock_guard<std::mutex> guard(lock);
+    std::vector<double> result;
+    if (data.segments > 0) {
+        result.resize(average.size());
+        for (size_t index = 0; index < average.size(); index++) {
+            result[index] = average[index] / 2 / data.noise_bandwidth;
+        }
+    }
+    return result;
+}
+
+/* ----------------------------------------------------- */
+
+wf::Welch::Data wf::Welch::status(void) {
+    /*
+        returns:    - the settings, the number of processed samples and segments
+    */
+    std::lock_guard<std::mutex> guard(lock);
+    return data;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Welch::reset(void) {
+    /*
+        restart the average, the settings are kept
+    */
+    std::lock_guard<std::mutex> guard(lock);
+    std::fill(average.begin(), average.end(), 0.0);
+    data.samples = 0;
+    data.segments = 0;
+    tail.clear();
+    tail_start = 0;
+    next = 0;
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Welch::close(void) {
+    /*
+        release the buffers
+    */
+    std::lock_guard<std::mutex> guard(lock);
+    workers.clear();
+    average.clear();
+    tail.clear();
+    tail.shrink_to_fit();
+    weights.clear();
+    window.reset();
+    data = Data();
+    return;
+}
+
+/* ----------------------------------------------------- */
+
+void wf::Welch::process(Worker &worker, const double *chunk, unsigned long long chunk_start, unsigned long long first, int count, const double *weight) {
+    /*
+        transform consecutive segments and add their weighted squared amplitudes to the sum of the thread
+    */
+    int length = data.segment_length;
+    const double *coefficients = window->data();
+    for (int segment = 0; segment < count; segment++) {
+        // copy the windowed segment, it can start in the samples kept from the previous chunk
+        unsigned long long start = first + (unsigned long long)segment * data.hop;
+        for (int index = 0; index < length; index++) {
+            unsigned long long position = start + index;
+            double value = position < chunk_start ? tail[position - tail_start] : chunk[position - chunk_start];
+            worker.segment[index] = value * coefficients[index];
+        }
+        fft.real(worker.segment.data(), length, worker.bins.data());
+
+        // squared amplitudes, scaled like tools.spectrum
+        for (size_t bin = 0; bin < worker.bins.size(); bin++) {
+            double scale = (bin == 0 || 2 * bin == (size_t)length) ? 1.0 / length : 2.0 / length;
+            worker.sum[bin] += weight[segment] * std::norm(worker.bins[bin]) * scale * scale;
+        }
+    }
+    return;
+}
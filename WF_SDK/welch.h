@@ -0,0 +1,75 @@
+/* WELCH SPECTRUM ANALYZER FUNCTIONS: open, push, spectrum, density, status, reset, close */
+
+/* include the necessary libraries */
+#include <vector>
+#include <complex>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "dwf.h"
+#include "fft.h"
+
+#ifndef WF_WELCH
+#define WF_WELCH
+namespace wf {
+
+class Welch {
+    public:
+        class Data {
+            public:
+                double sample_rate = 0;
+                int segment_length = 0;
+                int hop = 0;
+                double resolution = 0;              // bin spacing in Hz
+                double noise_bandwidth = 0;         // equivalent noise bandwidth of a bin in Hz
+                unsigned long long samples = 0;
+                unsigned long long segments = 0;
+                Data& operator=(const Data &data) {
+                    if (this != &data) {
+                        sample_rate = data.sample_rate;
+                        segment_length = data.segment_length;
+                        hop = data.hop;
+                        resolution = data.resolution;
+                        noise_bandwidth = data.noise_bandwidth;
+                        samples = data.samples;
+                        segments = data.segments;
+                    }
+                    return *this;
+                }
+        };
+
+    private:
+        class Worker {
+            /* buffers of a thread, allocated when the analyzer is opened */
+            public:
+                std::vector<double> segment;
+                std::vector<std::complex<double>> bins;
+                std::vector<double> sum;
+        };
+
+        std::mutex lock;
+        Data data;
+        int averages = 0;
+        int thread_count = 1;
+        std::shared_ptr<const std::vector<double>> window;
+        std::vector<double> average;        // averaged squared amplitude of every bin
+        std::vector<double> tail;           // samples of the unfinished segment
+        unsigned long long tail_start = 0;  // stream position of the first sample in tail
+        unsigned long long next = 0;        // stream position of the next segment
+        std::vector<Worker> workers;
+        std::vector<double> weights;
+        void process(Worker &worker, const double *chunk, unsigned long long chunk_start, unsigned long long first, int count, const double *weight);
+
+    public:
+        void open(double sample_rate, int segment_length = 4096, double overlap = 0.5, DwfWindow window = DwfWindowHann, int averages = 0, int threads = 0);
+        void push(const double *samples, int count);
+        void push(const std::vector<double> &samples);
+        std::vector<double> spectrum(void);
+        std::vector<double> density(void);
+        Data status(void);
+        void reset(void);
+        void close(void);
+} welch;
+
+}
+#endif
@@ -57,8 +57,15 @@ int main(void) {
                 // display a message
                 i2c.write(device_data, "Temp: ", CLS_address);
 
-                // read the temperature
-                std::vector<unsigned char> output_data = i2c.read(device_data, 2, TMP2_address);   // read 2 bytes
+                // read the temperature, a missing answer doesn't throw
+                unsigned char output_data[2];
+                Status status = i2c.try_read(device_data, output_data, 2, TMP2_address);   // read 2 bytes
+                if (status.code == Status::nak) {
+                    std::cout << "Warning: " << status.message() << std::endl;
+                    tools.sleep(1000);
+                    continue;
+                }
+                device.check_status(device_data, status);   // throw the other errors
                 int value = (int(output_data[0]) << 8) | int(output_data[1]);    // create integer from received bytes
                 double result;
                 if ((value >> 15) & 1 == 0) {
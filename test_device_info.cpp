@@ -12,6 +12,9 @@ int main(void) {
     try {
         device_data = device.open();
 
+        // query every information section, the instruments only query what they use
+        device.get_info(device_data, device.info.all);
+
         /* ----------------------------------------------------- */
 
         // set output file name
@@ -0,0 +1,79 @@
+#include "WF_SDK/WF_SDK.h"  // include all classes and functions
+#include <iostream>         // needed for input/output
+#include <string>           // needed for error handling
+#include <vector>
+#include <cmath>            // needed for sqrt
+
+using namespace wf;
+
+/* ----------------------------------------------------- */
+
+int main(void) {
+    try {
+        // connect to every available device
+        int count = manager.open();
+        std::cout << count << " devices opened" << std::endl;
+
+        /* ----------------------------------------------------- */
+
+        // start generating a 10KHz sine signal with 2V amplitude on channel 1 of every analog device at the same time
+        manager.run([](Manager::Unit &unit) {
+            if (unit.device_data->name != "Digital Discovery") {
+                unit.scope.open(unit.device_data);
+                unit.scope.trigger(unit.device_data, true, unit.scope.trigger_source.analog, 1, 0);
+                unit.wavegen.generate(unit.device_data, 1, unit.wavegen.function.sine, 0, 10e03, 2);
+            }
+        });
+        tools.sleep(1000);
+
+        // record the signal and the board temperature, each device on its own worker thread
+        std::vector<double> temperature(count, 0);
+        std::vector<double> rms(count, 0);
+        std::vector<std::future<void>> results;
+        for (int index = 0; index < count; index++) {
+            results.push_back(manager.submit(index, [&temperature, &rms, index](Manager::Unit &unit) {
+                temperature[index] = device.temperature(unit.device_data);
+                if (unit.device_data->name == "Digital Discovery") {
+                    return;
+                }
+
+                // record data with the scope on channel 1
+                std::vector<double> buffer = unit.scope.record(unit.device_data, 1);
+                double sum = 0;
+                for (size_t sample = 0; sample < buffer.size(); sample++) {
+                    sum += buffer[sample] * buffer[sample];
+                }
+                rms[index] = buffer.size() > 0 ? std::sqrt(sum / buffer.size()) : 0;
+
+                // reset the instruments
+                unit.scope.close(unit.device_data);
+                unit.wavegen.close(unit.device_data);
+            }));
+        }
+        for (int index = 0; index < count; index++) {
+            results[index].get();
+        }
+
+        // display the results
+        for (int index = 0; index < count; index++) {
+            Manager::Unit &unit = manager.unit(index);
+            std::cout << unit.device_data->name << " (" << unit.index << "): " << temperature[index] << "C, " << rms[index] << "V RMS" << std::endl;
+        }
+
+        /* ----------------------------------------------------- */
+
+        // close the connections
+        manager.close();
+    }
+
+    catch (Error error) {
+        // if an error occurs display it
+        std::cout << "Error: ";
+        std::cout << error.instrument << " -> ";
+        std::cout << error.function << " -> ";
+        std::cout << error.message << std::endl;
+        // close the connections
+        manager.close();
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "WF_SDK/WF_SDK.h"  // include all classes and functions
+#include <iostream>         // needed for input/output
+#include <string>           // needed for error handling
+#include <fstream>
+
+using namespace wf;
+
+/* ----------------------------------------------------- */
+
+int main(void) {
+    // connect to the device
+    Device::Data *device_data;
+    try {
+        device_data = device.open();
+
+        /* ----------------------------------------------------- */
+
+        // use instruments here
+        if (device_data->name != "Digital Discovery") {
+            // drive the DUT from wavegen channel 1, measure its input on scope channel 1 and its output on scope channel 2
+            network.open(device_data, 1, 1, 2, 1);
+
+            // sweep from 10Hz to 1MHz in 200 logarithmic steps
+            Network::Data response = network.sweep(device_data, 10, 1e06, 200);
+
+            // save the gain
+            std::ofstream file;
+            file.open("test_network-analyzer_gain.csv");
+            file << "frequency [Hz],gain [dB]\n";
+            for (int index = 0; index < response.frequency.size(); index++) {
+                file << std::to_string(response.frequency[index]) << "," << std::to_string(response.gain[index]) << std::endl;
+            }
+            file.close();
+
+            // plot
+            system("python plotting.py test_network-analyzer_gain.csv");
+
+            // save the phase
+            file.open("test_network-analyzer_phase.csv");
+            file << "frequency [Hz],phase [degrees]\n";
+            for (int index = 0; index < response.frequency.size(); index++) {
+                file << std::to_string(response.frequency[index]) << "," << std::to_string(response.phase[index]) << std::endl;
+            }
+            file.close();
+
+            // plot
+            system("python plotting.py test_network-analyzer_phase.csv");
+
+            // reset the scope and the wavegen
+            network.close(device_data);
+        }
+
+        /* ----------------------------------------------------- */
+
+        // close the connection
+        device.close(device_data);
+    }
+
+    catch (Error error) {
+        // if an error occurs display it
+        std::cout << "Error: ";
+        std::cout << error.instrument << " -> ";
+        std::cout << error.function << " -> ";
+        std::cout << error.message << std::endl;
+        // close the connection
+        device.close(device_data);
+    }
+    return 0;
+}
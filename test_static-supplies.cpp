@@ -1,6 +1,5 @@
 #include "WF_SDK/WF_SDK.h"  // include all classes and functions
 #include <iostream>         // needed for input/output
-#include <cmath>            // needed for power function
 #include <string>           // needed for error handling
 
 using namespace wf;
@@ -25,9 +24,7 @@ int main(void) {
         supplies.switch_(device_data, supplies_data);
         
         // set all pins as output
-        for (int index = 0; index < 16; index++) {
-            static_.set_mode(device_data, index, true);
-        }
+        static_.set_modes(device_data, 0xFFFF, 0xFFFF);
 
         tools.keyboard_interrupt_reset(device_data);
 
@@ -39,11 +36,8 @@ int main(void) {
 
             while (mask < 0x10000) {
                 // go through possible states
-                for (int index = 0; index < 16; index++) {
-                    // set the state of every DIO channel
-                    bool  state = bool(mask & int(pow(2, index)));
-                    static_.set_state(device_data, index, !state);
-                }
+                // set the state of every DIO channel at once
+                static_.set_states(device_data, 0xFFFF, ~mask);
                 tools.sleep(100);  // delay
                 mask <<= 1;  // switch mask
             }
@@ -51,11 +45,8 @@ int main(void) {
             while (mask > 1) {
                 // go through possible states backward
                 mask >>= 1;  // switch mask
-                for (int index = 0; index < 16; index++) {
-                    // set the state of every DIO channel
-                    bool state = bool(mask & int(pow(2, index)));
-                    static_.set_state(device_data, index, !state);
-                }
+                // set the state of every DIO channel at once
+                static_.set_states(device_data, 0xFFFF, ~mask);
                 tools.sleep(100);  // delay
             }
         }
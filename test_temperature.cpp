@@ -20,11 +20,12 @@ int main(void) {
 
         std::cout << "Press Ctrl+C to exit..." << std::endl;
 
-        while (true) {
+        // read the temperature every 500ms, the processor sleeps between the readings
+        scheduler.every(0.5, [device_data]() {
             double temp = device.temperature(device_data);  // get board temperature
             std::cout << "board temperature: " << std::ceil(temp * 100.0) / 100.0 << "C" << std::endl;  // display temperature
-            tools.sleep(500);
-        }
+        });
+        scheduler.run();
     }
 
     catch (Error error) {